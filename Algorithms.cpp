@@ -1,4 +1,8 @@
 #include "Algorithms.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <thread>
 using namespace graph;
 
 // Runs BFS (Breadth-First Search) from source vertex s.
@@ -39,7 +43,7 @@ Graph Algorithms::bfs(const Graph &g, int s)
         }
     }
 
-    Graph bfsTree(n);
+    Graph bfsTree(n, g.isDirected());
     for (int i = 0; i < n; i++) {
         if (parent[i] != -1 && parent[i] != i) {
             bfsTree.addEdge(parent[i], i, weightParent[i]);
@@ -54,14 +58,14 @@ Graph Algorithms::bfs(const Graph &g, int s)
 // Helper for DFS: visits one node and goes deeper recursively.
 // Marks visited nodes and builds the DFS tree step by step.
 // Called by the main DFS function.
-void Algorithms::dfs_visit(const Graph &g, int u, bool *visited, Graph &dfsTree)
+void Algorithms::dfs_visit(const Graph &g, int u, Bitset &visited, Graph &dfsTree)
 {
-    visited[u] = true;                         // Mark current node as visited
+    visited.set(u);                            // Mark current node as visited
     Node *neighbor = g.getAdjList()[u];
 
     while (neighbor != nullptr) {
         int v = neighbor->vertex;
-        if (!visited[v]) {
+        if (!visited.test(v)) {
             dfsTree.addEdge(u, v, neighbor->weight); // Add edge to DFS tree
             dfs_visit(g, v, visited, dfsTree);        // Visit neighbor
         }
@@ -79,32 +83,31 @@ Graph Algorithms::dfs(const Graph &g, int s)
     }
 
     int n = g.getNumVertices();
-    bool *visited = new bool[n];
-    for (int i = 0; i < n; i++) visited[i] = false;  // All not visited
+    Bitset visited(n);                               // All not visited
 
-    Graph dfsTree(n);
+    Graph dfsTree(n, g.isDirected());
 
     // Go from s to end
     for (int i = s; i < n; i++) {
-        if (!visited[i]) {
+        if (!visited.test(i)) {
             dfs_visit(g, i, visited, dfsTree);
         }
     }
     // Then wrap around from 0 to s-1
     for (int i = 0; i < s; i++) {
-        if (!visited[i]) {
+        if (!visited.test(i)) {
             dfs_visit(g, i, visited, dfsTree);
         }
     }
 
-    delete[] visited;
     return dfsTree;
 }
 
 // Runs Dijkstra's algorithm to find shortest paths from s.
 // Builds the shortest-path tree with edge weights.
-// Uses a min-priority queue to choose next closest node.
+// Uses a min-priority queue (PQ) to choose next closest node.
 // Throws if graph has negative edge weights.
+template <class PQ>
 Graph Algorithms::dijkstra(const Graph &g, int s)
 {
     if (g.getIsNegative()) {
@@ -127,12 +130,15 @@ Graph Algorithms::dijkstra(const Graph &g, int s)
     dist[s] = 0;
     parent[s] = s;
 
-    MinPriorityQueue mpq(n);
+    PQ mpq(n);
     mpq.insert(s, 0);
 
     while (!mpq.isEmpty()) {
         Pair curr = mpq.extractMin();    // Get node with smallest distance
         int u = curr.vertex;
+        if (curr.distance > dist[u]) {
+            continue;                    // Stale entry of a lazy queue, u was settled closer
+        }
 
         Node *neighbor = g.getAdjList()[u];
         while (neighbor != nullptr) {
@@ -154,7 +160,7 @@ Graph Algorithms::dijkstra(const Graph &g, int s)
         }
     }
 
-    Graph dijkstraTree(n);
+    Graph dijkstraTree(n, g.isDirected());
     for (int i = 0; i < n; i++) {
         if (parent[i] != -1 && parent[i] != i) {
             dijkstraTree.addEdge(parent[i], i, weightParent[i]);
@@ -167,42 +173,205 @@ Graph Algorithms::dijkstra(const Graph &g, int s)
     return dijkstraTree;
 }
 
+// The priority queues dijkstra and prim are compiled for
+template Graph Algorithms::dijkstra<MinPriorityQueue>(const Graph &, int);
+template Graph Algorithms::dijkstra<PairingHeap>(const Graph &, int);
+template Graph Algorithms::dijkstra<LazyMinHeap>(const Graph &, int);
+
+// Validates the source vertex and that the workspace fits the graph.
+void Algorithms::checkWorkspace(int n, int s, const Workspace &ws, const char *who)
+{
+    if (s < 0 || s >= n) {
+        throw std::out_of_range(std::string(who) + ": Source vertex index out of bounds");
+    }
+    if (ws.getNumVertices() != n) {
+        throw std::invalid_argument(std::string(who) + ": Workspace size does not match the graph");
+    }
+}
+
+// BFS from s into a reusable workspace.
+// Leaves the hop count and parent of every reached vertex in ws.
+// Nothing is allocated or cleared, only the reached vertices are touched.
+// Stops early at limits.target, limits.maxHops or limits.maxSettled.
+template <class G>
+void Algorithms::bfs(const G &g, int s, Workspace &ws, const SearchLimits &limits)
+{
+    checkWorkspace(g.getNumVertices(), s, ws, "bfs");
+    ws.reset();
+    if (limits.maxSettled == 0) {
+        return;                          // Not even the source may be settled
+    }
+
+    Queue &q = ws.getQueue();
+    ws.reach(s, 0, s);
+    ws.settle(s);                        // BFS distances are final when found
+    if (s == limits.target || limits.maxSettled == 1) {
+        return;
+    }
+    q.enqueue(s);
+
+    bool done = false;
+    while (!q.isEmpty() && !done) {
+        int curr = q.dequeue();
+        int hops = ws.getDistance(curr) + 1;
+        if (limits.maxHops >= 0 && hops > limits.maxHops) {
+            return;                      // Queue is in hop order, the rest is too far
+        }
+        done = !g.forEachAdjacent(curr, [&](int v) {
+            if (!ws.isReached(v)) {
+                ws.reach(v, hops, curr);
+                ws.settle(v);
+                if (v == limits.target || ws.getVisitedCount() == limits.maxSettled) {
+                    return false;        // Stop the whole search
+                }
+                q.enqueue(v);
+            }
+            return true;
+        });
+    }
+}
+
+// BFS that follows edges backwards, from t to every vertex that can reach it.
+// On a directed graph this needs the in-edge lists (trackInEdges).
+void Algorithms::reverseBfs(const Graph &g, int t, Workspace &ws, const SearchLimits &limits)
+{
+    checkWorkspace(g.getNumVertices(), t, ws, "reverseBfs");
+    if (g.isDirected() && !g.hasInEdges()) {
+        throw std::logic_error("reverseBfs requires a graph that tracks in-edges.");
+    }
+    bfs(g.inEdgeView(), t, ws, limits);
+}
+
+// Level-synchronous BFS where the frontier is a bitmap rather than a queue.
+// Every round marks the neighbors of the whole frontier in next, then drops the
+// already visited ones with one andNot over the words: no per-vertex checks and
+// no queue pushes, which pays off when the frontiers cover much of the graph.
+int Algorithms::bfsLevels(const CompactGraph &g, int s, int *level)
+{
+    int n = g.getNumVertices();
+    if (s < 0 || s >= n) {
+        throw std::out_of_range("bfsLevels: Source vertex index out of bounds");
+    }
+    for (int i = 0; i < n; i++) level[i] = -1;
+
+    Bitset visited(n);
+    Bitset frontier(n);
+    Bitset next(n);
+    visited.set(s);
+    frontier.set(s);
+    level[s] = 0;
+    int depth = 0;
+
+    while (frontier.any()) {
+        next.clear();
+        for (int u = frontier.findNext(0); u != -1; u = frontier.findNext(u + 1)) {
+            g.forEachAdjacent(u, [&](int v) {
+                next.set(v);
+                return true;
+            });
+        }
+        next.andNot(visited);            // Keep only vertices seen for the first time
+        visited.orWith(next);
+        if (!next.any()) {
+            break;
+        }
+        depth++;
+        for (int v = next.findNext(0); v != -1; v = next.findNext(v + 1)) {
+            level[v] = depth;
+        }
+        frontier.swap(next);
+    }
+    return depth + 1;
+}
+
+// Dijkstra from s into a reusable workspace.
+// Leaves the distance and parent of every reached vertex in ws.
+// An unreached vertex has no distance yet, so no "infinity" fill is needed.
+// Stops early at limits.target, limits.maxDistance or limits.maxSettled.
+template <class G>
+void Algorithms::dijkstra(const G &g, int s, Workspace &ws, const SearchLimits &limits)
+{
+    if (g.getIsNegative()) {
+        throw std::logic_error("Dijkstra cannot run on graphs with negative edge weights.");
+    }
+    checkWorkspace(g.getNumVertices(), s, ws, "dijkstra");
+    ws.reset();
+    if (limits.maxSettled == 0) {
+        return;
+    }
+
+    MinPriorityQueue &mpq = ws.getHeap();
+    ws.reach(s, 0, s);
+    mpq.insert(s, 0);
+
+    while (!mpq.isEmpty()) {
+        Pair curr = mpq.extractMin();
+        int u = curr.vertex;
+        ws.settle(u);
+        if (u == limits.target || ws.getVisitedCount() == limits.maxSettled) {
+            return;
+        }
+
+        g.forEachNeighbor(u, [&](int v, int w) {
+            int d = curr.distance + w;
+            if (limits.maxDistance < 0 || d <= limits.maxDistance) {  // Farther ones never enter the queue
+                if (!ws.isReached(v)) {
+                    ws.reach(v, d, u);
+                    mpq.insert(v, d);
+                } else if (d < ws.getDistance(v)) {
+                    ws.update(v, d, u);
+                    mpq.decreaseKey(v, d);
+                }
+            }
+            return true;
+        });
+    }
+}
+
+// The graph types the workspace traversals are compiled for
+template void Algorithms::bfs<Graph>(const Graph &, int, Workspace &, const SearchLimits &);
+template void Algorithms::bfs<GraphSnapshot>(const GraphSnapshot &, int, Workspace &, const SearchLimits &);
+template void Algorithms::dijkstra<Graph>(const Graph &, int, Workspace &, const SearchLimits &);
+template void Algorithms::dijkstra<GraphSnapshot>(const GraphSnapshot &, int, Workspace &, const SearchLimits &);
+template void Algorithms::bfs<CompactGraph>(const CompactGraph &, int, Workspace &, const SearchLimits &);
+template void Algorithms::bfs<CompressedGraph>(const CompressedGraph &, int, Workspace &, const SearchLimits &);
+template void Algorithms::dijkstra<CompactGraph>(const CompactGraph &, int, Workspace &, const SearchLimits &);
+template void Algorithms::dijkstra<CompressedGraph>(const CompressedGraph &, int, Workspace &, const SearchLimits &);
+
 // Runs Prim's algorithm to find a Minimum Spanning Tree.
 // First checks if the graph is connected using BFS.
 // Then uses a priority queue to grow the MST.
 // Returns the MST as a new graph.
+template <class PQ>
 Graph Algorithms::prim(const Graph &g, int randS)
 {
+    if (g.isDirected()) {
+        throw std::logic_error("Prim requires an undirected graph.");
+    }
     if (randS < 0 || randS >= g.getNumVertices()) {
         throw std::out_of_range("prim: Source vertex index out of bounds");
     }
 
-    // First check if graph is connected
-    Graph bfsTree = Algorithms::bfs(g, randS);
-    int edgeCount = 0;
-    for (int i = 0; i < bfsTree.getNumVertices(); i++) {
-        Node* curr = bfsTree.getAdjList()[i];
-        while (curr != nullptr) {
-            edgeCount++;
-            curr = curr->next;
-        }
-    }
-    edgeCount /= 2;  // Because undirected edges counted twice
+    int n = g.getNumVertices();
 
-    if (edgeCount < g.getNumVertices() - 1) {
+    // First check if graph is connected: BFS from randS has to reach every vertex
+    if (g.getEdgeCount() < n - 1) {
+        throw std::logic_error("Prim requires a connected graph.");
+    }
+    Workspace ws(n);
+    Algorithms::bfs(g, randS, ws);
+    if (ws.getVisitedCount() < n) {
         throw std::logic_error("Prim requires a connected graph.");
     }
 
-    int n = g.getNumVertices();
-    bool *inMST = new bool[n];           // Tracks which nodes are in MST
+    Bitset inMST(n);                     // Tracks which nodes are in MST
     int *parent = new int[n];
     int *key = new int[n];               // Best edge weight to MST
-    MinPriorityQueue mpq(n);
+    PQ mpq(n);
 
     for (int i = 0; i < n; i++) {
         key[i] = 9999;
         parent[i] = -1;
-        inMST[i] = false;
     }
 
     key[randS] = 0;
@@ -211,14 +380,16 @@ Graph Algorithms::prim(const Graph &g, int randS)
     while (!mpq.isEmpty()) {
         Pair curr = mpq.extractMin();    // Get node with smallest key
         int u = curr.vertex;
-        inMST[u] = true;
+        if (inMST.testAndSet(u)) {
+            continue;                    // Stale entry of a lazy queue, u is already in the MST
+        }
 
         Node *neigbor = g.getAdjList()[u];
         while (neigbor != nullptr) {
             int v = neigbor->vertex;
             int w = neigbor->weight;
 
-            if (!inMST[v] && w < key[v]) {
+            if (!inMST.test(v) && w < key[v]) {
                 key[v] = w;              // Update best edge to v
                 parent[v] = u;
 
@@ -239,11 +410,13 @@ Graph Algorithms::prim(const Graph &g, int randS)
         }
     }
 
-    delete[] inMST;
     delete[] key;
     delete[] parent;
     return mst;
 }
+template Graph Algorithms::prim<MinPriorityQueue>(const Graph &, int);
+template Graph Algorithms::prim<PairingHeap>(const Graph &, int);
+template Graph Algorithms::prim<LazyMinHeap>(const Graph &, int);
 
 // Goes over the graph and collects all edges (no duplicates).
 // Only adds edge (u,v) when v > u to avoid counting both directions.
@@ -253,7 +426,7 @@ Edge* Algorithms::extractEdgesFromGraph(const Graph &g, int& edgeCount)
     int n = g.getNumVertices();
     Node** adj = g.getAdjList();
 
-    Edge* edges = new Edge[n * (n - 1) / 2]; // Max possible
+    Edge* edges = new Edge[g.getEdgeCount()]; // The graph keeps the count
     edgeCount = 0;
 
     for (int u = 0; u < n; u++) {
@@ -278,6 +451,9 @@ Edge* Algorithms::extractEdgesFromGraph(const Graph &g, int& edgeCount)
 // Returns MST as a new Graph.
 Graph Algorithms::kruskal(const Graph &g)
 {
+    if (g.isDirected()) {
+        throw std::logic_error("Kruskal requires an undirected graph.");
+    }
     int n = g.getNumVertices();
     int edgeCount = 0;
 
@@ -287,12 +463,11 @@ Graph Algorithms::kruskal(const Graph &g)
     UnionFind uf(n);
     Graph mst(n);
 
-    for (int i = 0; i < edgeCount; i++) {
+    for (int i = 0; i < edgeCount && uf.componentCount() > 1; i++) {
         int u = edge[i].u;
         int v = edge[i].v;
 
-        if (!uf.connected(u, v)) {
-            uf.unite(u, v);                     // Join sets
+        if (uf.unite(u, v)) {                   // Joined two sets
             mst.addEdge(u, v, edge[i].weight);  // Add edge to MST
         }
     }
@@ -300,3 +475,488 @@ Graph Algorithms::kruskal(const Graph &g)
     delete[] edge;
     return mst;
 }
+
+// Fills one row of shortest distances from s, using dist itself as the distance array.
+// The queue is empty again when the run ends, so the caller can reuse it for the
+// next source without any new allocation.
+void Algorithms::dijkstraRow(const Graph &g, int s, int *dist, MinPriorityQueue &mpq)
+{
+    const int INF = std::numeric_limits<int>::max();
+    int n = g.getNumVertices();
+    for (int i = 0; i < n; i++) {
+        dist[i] = INF;
+    }
+    dist[s] = 0;
+    mpq.insert(s, 0);
+
+    while (!mpq.isEmpty()) {
+        int u = mpq.extractMin().vertex;
+
+        Node *neighbor = g.getAdjList()[u];
+        while (neighbor != nullptr) {
+            int v = neighbor->vertex;
+            if (dist[u] + neighbor->weight < dist[v]) {
+                dist[v] = dist[u] + neighbor->weight;
+                if (mpq.contains(v)) {
+                    mpq.decreaseKey(v, dist[v]);
+                } else {
+                    mpq.insert(v, dist[v]);
+                }
+            }
+            neighbor = neighbor->next;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        if (dist[i] == INF) {
+            dist[i] = -1;               // Not reachable from s
+        }
+    }
+}
+
+// Runs worker on numThreads threads (0 = hardware concurrency, never more than
+// tasks) and waits for all of them. The calling thread is one of the workers.
+template <class F>
+static void runInParallel(int numThreads, long long tasks, F worker)
+{
+    if (numThreads <= 0) {
+        numThreads = (int)std::thread::hardware_concurrency();
+        if (numThreads <= 0) numThreads = 1;
+    }
+    if (numThreads > tasks) numThreads = (int)tasks;
+    if (numThreads <= 0) return;
+    if (numThreads == 1) {
+        worker();
+        return;
+    }
+    std::thread *threads = new std::thread[numThreads - 1];
+    for (int t = 0; t < numThreads - 1; t++) {
+        threads[t] = std::thread(worker);
+    }
+    worker();
+    for (int t = 0; t < numThreads - 1; t++) {
+        threads[t].join();
+    }
+    delete[] threads;
+}
+
+// Runs Dijkstra from many sources against the same graph.
+// Each worker thread owns one priority queue for its whole lifetime and writes
+// straight into its output rows, so a single query allocates nothing.
+// Workers pull the next source from a shared counter to balance uneven queries.
+void Algorithms::dijkstraBatch(const Graph &g, const int *sources, int count, int *distances, int numThreads)
+{
+    if (g.getIsNegative()) {
+        throw std::logic_error("Dijkstra cannot run on graphs with negative edge weights.");
+    }
+    if (count < 0 || (count > 0 && (sources == nullptr || distances == nullptr))) {
+        throw std::invalid_argument("dijkstraBatch: Invalid source or output array");
+    }
+    int n = g.getNumVertices();
+    for (int i = 0; i < count; i++) {
+        if (sources[i] < 0 || sources[i] >= n) {
+            throw std::out_of_range("dijkstraBatch: Source vertex index out of bounds");
+        }
+    }
+
+    std::atomic<int> next(0);
+    runInParallel(numThreads, count, [&]() {
+        MinPriorityQueue mpq(n);        // Scratch queue reused for every source
+        for (int i = next++; i < count; i = next++) {
+            dijkstraRow(g, sources[i], distances + (long long)i * n, mpq);
+        }
+    });
+}
+
+// Finds the strongly connected components with Tarjan's algorithm.
+// Written with an explicit stack so long paths cannot overflow the call stack.
+// component[v] gets the id of v's component; returns the number of components.
+// On an undirected graph these are simply the connected components.
+int Algorithms::stronglyConnectedComponents(const Graph &g, int *component)
+{
+    int n = g.getNumVertices();
+    Node **adj = g.getAdjList();
+    int *order = new int[n];        // discovery index, -1 if not visited yet
+    int *low = new int[n];          // smallest index reachable from the subtree
+    bool *onStack = new bool[n];
+    int *stack = new int[n];        // vertices waiting for their component
+    int *callStack = new int[n];    // the DFS path
+    Node **nextEdge = new Node *[n];
+    for (int i = 0; i < n; i++) {
+        order[i] = -1;
+        onStack[i] = false;
+    }
+
+    int counter = 0;
+    int components = 0;
+    int top = 0;
+    for (int root = 0; root < n; root++) {
+        if (order[root] != -1) {
+            continue;
+        }
+        int depth = 0;
+        callStack[depth++] = root;
+        order[root] = low[root] = counter++;
+        nextEdge[root] = adj[root];
+        stack[top++] = root;
+        onStack[root] = true;
+
+        while (depth > 0) {
+            int u = callStack[depth - 1];
+            if (nextEdge[u] != nullptr) {
+                int v = nextEdge[u]->vertex;
+                nextEdge[u] = nextEdge[u]->next;
+                if (order[v] == -1) {               // Go deeper
+                    order[v] = low[v] = counter++;
+                    nextEdge[v] = adj[v];
+                    stack[top++] = v;
+                    onStack[v] = true;
+                    callStack[depth++] = v;
+                } else if (onStack[v] && order[v] < low[u]) {
+                    low[u] = order[v];
+                }
+                continue;
+            }
+            depth--;                                // All edges of u are done
+            if (low[u] == order[u]) {               // u is the root of a component
+                int v;
+                do {
+                    v = stack[--top];
+                    onStack[v] = false;
+                    component[v] = components;
+                } while (v != u);
+                components++;
+            }
+            if (depth > 0) {
+                int parent = callStack[depth - 1];
+                if (low[u] < low[parent]) {
+                    low[parent] = low[u];
+                }
+            }
+        }
+    }
+
+    delete[] order;
+    delete[] low;
+    delete[] onStack;
+    delete[] stack;
+    delete[] callStack;
+    delete[] nextEdge;
+    return components;
+}
+
+// Counts the vertices in both sorted neighbor lists.
+// Lists that are sets go through the SIMD kernel; with parallel edges or
+// self loops a vertex may repeat, and then the plain merge counts it once.
+int Algorithms::commonNeighbors(const CompactGraph &g, int u, int v)
+{
+    const int *a = g.getNeighbors(u);
+    const int *b = g.getNeighbors(v);
+    if (g.hasRepeatedNeighbors()) {
+        return Intersection::countDistinct(a, g.getDegree(u), b, g.getDegree(v));
+    }
+    return Intersection::count(a, g.getDegree(u), b, g.getDegree(v));
+}
+
+// Jaccard similarity of the neighborhoods of u and v
+double Algorithms::jaccard(const CompactGraph &g, int u, int v)
+{
+    int common = commonNeighbors(g, u, v);
+    int du = g.getDegree(u);
+    int dv = g.getDegree(v);
+    if (g.hasRepeatedNeighbors()) {
+        du = Intersection::distinct(g.getNeighbors(u), du);
+        dv = Intersection::distinct(g.getNeighbors(v), dv);
+    }
+    int together = du + dv - common;
+    return together == 0 ? 0.0 : (double)common / together;
+}
+
+// Number of different neighbors of u other than u itself
+static int simpleDegree(const CompactGraph &g, int u)
+{
+    const int *list = g.getNeighbors(u);
+    int d = g.getDegree(u);
+    int values = Intersection::distinct(list, d);
+    if (Intersection::count(list, d, &u, 1) > 0) {
+        values--;                        // the self loop
+    }
+    return values;
+}
+
+// Counts triangles in an undirected graph (self loops and parallel edges ignored).
+// Every edge is pointed from the end with the lower (degree, id) to the other
+// one, so each vertex keeps at most about sqrt(2m) out-neighbors and each
+// triangle is found exactly once, at its lowest vertex, by intersecting two
+// out-lists. Vertices are handed to the threads in small chunks.
+// If perVertex is not null, perVertex[v] gets the number of triangles through v.
+long long Algorithms::countTriangles(const CompactGraph &g, long long *perVertex, int numThreads)
+{
+    if (g.isDirected()) {
+        throw std::logic_error("countTriangles requires an undirected graph.");
+    }
+    int n = g.getNumVertices();
+    int *degree = new int[n];
+    for (int u = 0; u < n; u++) {
+        degree[u] = simpleDegree(g, u);
+    }
+    auto below = [&](int u, int v) {
+        return degree[u] < degree[v] || (degree[u] == degree[v] && u < v);
+    };
+
+    // The oriented graph, still sorted by id inside each list
+    long long *offsets = new long long[n + 1];
+    offsets[0] = 0;
+    for (int u = 0; u < n; u++) {
+        const int *list = g.getNeighbors(u);
+        int d = g.getDegree(u);
+        long long out = 0;
+        for (int i = 0; i < d; i++) {
+            if ((i == 0 || list[i] != list[i - 1]) && below(u, list[i])) out++;
+        }
+        offsets[u + 1] = offsets[u] + out;
+    }
+    int *up = new int[offsets[n]];
+    int maxOut = 0;
+    for (int u = 0; u < n; u++) {
+        const int *list = g.getNeighbors(u);
+        int d = g.getDegree(u);
+        long long at = offsets[u];
+        for (int i = 0; i < d; i++) {
+            if ((i == 0 || list[i] != list[i - 1]) && below(u, list[i])) up[at++] = list[i];
+        }
+        maxOut = std::max(maxOut, (int)(offsets[u + 1] - offsets[u]));
+    }
+    delete[] degree;
+
+    std::atomic<long long> *counts = nullptr;
+    if (perVertex != nullptr) {
+        counts = new std::atomic<long long>[n];
+        for (int v = 0; v < n; v++) counts[v].store(0, std::memory_order_relaxed);
+    }
+    const int chunk = 256;
+    int chunks = (n + chunk - 1) / chunk;
+    std::atomic<int> nextChunk(0);
+    std::atomic<long long> total(0);
+    runInParallel(numThreads, chunks, [&]() {
+        long long found = 0;
+        int *common = counts != nullptr ? new int[maxOut + 1] : nullptr;
+        for (int c = nextChunk++; c < chunks; c = nextChunk++) {
+            int last = std::min(n, (c + 1) * chunk);
+            for (int u = c * chunk; u < last; u++) {
+                const int *a = up + offsets[u];
+                int na = (int)(offsets[u + 1] - offsets[u]);
+                long long atU = 0;
+                for (int i = 0; i < na; i++) {
+                    int v = a[i];
+                    const int *b = up + offsets[v];
+                    int nb = (int)(offsets[v + 1] - offsets[v]);
+                    if (counts == nullptr) {
+                        found += Intersection::count(a, na, b, nb);
+                        continue;
+                    }
+                    int k = Intersection::intersect(a, na, b, nb, common);
+                    if (k == 0) continue;
+                    atU += k;
+                    counts[v].fetch_add(k, std::memory_order_relaxed);
+                    for (int j = 0; j < k; j++) {
+                        counts[common[j]].fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+                if (atU > 0) {
+                    found += atU;
+                    counts[u].fetch_add(atU, std::memory_order_relaxed);
+                }
+            }
+        }
+        delete[] common;
+        total += found;
+    });
+
+    if (counts != nullptr) {
+        for (int v = 0; v < n; v++) perVertex[v] = counts[v].load(std::memory_order_relaxed);
+        delete[] counts;
+    }
+    delete[] offsets;
+    delete[] up;
+    return total;
+}
+
+// Local clustering coefficient of every vertex: the share of pairs of its
+// neighbors that are adjacent, 2 * triangles / (d * (d - 1)), and 0 when d < 2.
+// Returns the average over all vertices.
+double Algorithms::clusteringCoefficients(const CompactGraph &g, double *coefficients, int numThreads)
+{
+    if (coefficients == nullptr) {
+        throw std::invalid_argument("clusteringCoefficients: Output array is null");
+    }
+    int n = g.getNumVertices();
+    long long *triangles = new long long[n];
+    countTriangles(g, triangles, numThreads);
+    double sum = 0;
+    for (int v = 0; v < n; v++) {
+        long long d = simpleDegree(g, v);
+        coefficients[v] = d < 2 ? 0.0 : 2.0 * triangles[v] / (d * (d - 1));
+        sum += coefficients[v];
+    }
+    delete[] triangles;
+    return n == 0 ? 0.0 : sum / n;
+}
+
+// Renumbers the set ids in root so components are numbered 0, 1, 2, ... in the
+// order their first vertex appears. root[v] is any id of v's set in 0..n-1.
+static int labelByFirstVertex(int n, const int *root, int *component)
+{
+    int *label = new int[n];
+    for (int v = 0; v < n; v++) {
+        label[v] = -1;
+    }
+    int components = 0;
+    for (int v = 0; v < n; v++) {
+        if (label[root[v]] == -1) {
+            label[root[v]] = components++;
+        }
+        component[v] = label[root[v]];
+    }
+    delete[] label;
+    return components;
+}
+
+// Connected components with union-find over the edges, one pass and no search.
+// A directed graph gives its weakly connected components.
+// component[v] gets the id of v's component (numbered by first vertex); returns how many.
+int Algorithms::connectedComponents(const Graph &g, int *component)
+{
+    if (component == nullptr) {
+        throw std::invalid_argument("connectedComponents: Output array is null");
+    }
+    int n = g.getNumVertices();
+    UnionFind uf(n);
+    for (int u = 0; u < n; u++) {
+        g.forEachAdjacent(u, [&](int v) {
+            uf.unite(u, v);
+            return true;
+        });
+    }
+    int *root = new int[n];
+    for (int v = 0; v < n; v++) {
+        root[v] = uf.find(v);
+    }
+    int components = labelByFirstVertex(n, root, component);
+    delete[] root;
+    return components;
+}
+
+// Shiloach-Vishkin style rounds. Every vertex points at a smaller or equal vertex,
+// so the trees can never form a cycle. Rounds of two phases run until nothing changes:
+//  hook - for each edge whose ends have different roots, the larger root is
+//         pointed at the smaller parent with a CAS (only if it is still a root)
+//  shortcut - each vertex jumps to its grandparent until it points at a root
+// At the end root[v] is the smallest vertex of the component of v.
+static void hookAndShortcut(const CompactGraph &g, int *root, int numThreads)
+{
+    int n = g.getNumVertices();
+    std::atomic<int> *parent = new std::atomic<int>[n];
+    for (int v = 0; v < n; v++) {
+        parent[v].store(v, std::memory_order_relaxed);
+    }
+    const int chunk = 1024;
+    int chunks = (n + chunk - 1) / chunk;
+
+    // Points root big at small if big is still a root
+    auto hook = [&](int big, int small) {
+        int expected = big;
+        return parent[big].compare_exchange_strong(expected, small, std::memory_order_relaxed);
+    };
+    bool changed = true;
+    while (changed) {
+        std::atomic<bool> hooked(false);
+        std::atomic<int> nextChunk(0);
+        runInParallel(numThreads, chunks, [&]() {
+            bool any = false;
+            for (int c = nextChunk++; c < chunks; c = nextChunk++) {
+                int last = std::min(n, (c + 1) * chunk);
+                for (int u = c * chunk; u < last; u++) {
+                    g.forEachAdjacent(u, [&](int v) {
+                        int pu = parent[u].load(std::memory_order_relaxed);
+                        int pv = parent[v].load(std::memory_order_relaxed);
+                        if (pu < pv) {
+                            any |= hook(pv, pu);
+                        } else if (pv < pu) {
+                            any |= hook(pu, pv);
+                        }
+                        return true;
+                    });
+                }
+            }
+            if (any) hooked = true;
+        });
+        changed = hooked;
+
+        nextChunk = 0;
+        runInParallel(numThreads, chunks, [&]() {
+            for (int c = nextChunk++; c < chunks; c = nextChunk++) {
+                int last = std::min(n, (c + 1) * chunk);
+                for (int v = c * chunk; v < last; v++) {
+                    int p = parent[v].load(std::memory_order_relaxed);
+                    int grand = parent[p].load(std::memory_order_relaxed);
+                    while (p != grand) {
+                        p = grand;
+                        grand = parent[p].load(std::memory_order_relaxed);
+                    }
+                    parent[v].store(p, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (int v = 0; v < n; v++) {
+        root[v] = parent[v].load(std::memory_order_relaxed);
+    }
+    delete[] parent;
+}
+
+// One pass over the edges, the threads uniting edge ends in a shared ConcurrentUnionFind.
+// No rounds: each edge is looked at once. root[v] gets the smallest vertex of the component of v.
+static void concurrentUnionFind(const CompactGraph &g, int *root, int numThreads)
+{
+    int n = g.getNumVertices();
+    bool directed = g.isDirected();
+    ConcurrentUnionFind uf(n);
+    const int chunk = 1024;
+    int chunks = (n + chunk - 1) / chunk;
+    std::atomic<int> nextChunk(0);
+    runInParallel(numThreads, chunks, [&]() {
+        for (int c = nextChunk++; c < chunks; c = nextChunk++) {
+            int last = std::min(n, (c + 1) * chunk);
+            for (int u = c * chunk; u < last; u++) {
+                g.forEachAdjacent(u, [&](int v) {
+                    if (directed || v < u) uf.unite(u, v);   // an undirected edge is listed at both ends
+                    return true;
+                });
+            }
+        }
+    });
+    for (int v = 0; v < n; v++) {
+        root[v] = uf.find(v);
+    }
+}
+
+// Parallel connected components, labelled like connectedComponents.
+// strategy picks hook/shortcut rounds or a single concurrent union-find pass.
+int Algorithms::parallelConnectedComponents(const CompactGraph &g, int *component, int numThreads, ComponentStrategy strategy)
+{
+    if (component == nullptr) {
+        throw std::invalid_argument("parallelConnectedComponents: Output array is null");
+    }
+    int n = g.getNumVertices();
+    int *root = new int[n];
+    if (strategy == CONCURRENT_UNION_FIND) {
+        concurrentUnionFind(g, root, numThreads);
+    } else {
+        hookAndShortcut(g, root, numThreads);
+    }
+    int components = labelByFirstVertex(n, root, component);
+    delete[] root;
+    return components;
+}
@@ -3,18 +3,71 @@
 #include <iostream>
 #include "Graph.hpp"
 #include "DataStructures.hpp"
+#include "VersionedGraph.hpp"
+#include "CompactGraph.hpp"
+#include "Intersection.hpp"
 #include <stdexcept>
 namespace graph{
+    // Stopping rules for the workspace traversals, -1 means no limit
+    struct SearchLimits {
+        int target = -1;        // stop as soon as this vertex is settled
+        int maxHops = -1;       // bfs: ignore vertices more than maxHops edges away
+        int maxDistance = -1;   // dijkstra: ignore vertices farther than maxDistance
+        int maxSettled = -1;    // stop after this many vertices are settled (0 = none, not even s)
+    };
+
+    // How parallelConnectedComponents finds the components
+    enum ComponentStrategy {
+        HOOK_AND_SHORTCUT,      // Shiloach-Vishkin rounds of CAS hooking and pointer jumping
+        CONCURRENT_UNION_FIND   // one pass of lock-free unites, no rounds
+    };
+
     class Algorithms{
         public:
             static Graph bfs(const Graph& g, int s);
             static Graph dfs (const Graph& g, int s);
-            static Graph dijkstra(const Graph& g, int s);
-            static Graph prim(const Graph& g, int randomS);
+            // PQ is the priority queue: MinPriorityQueue (binary heap), PairingHeap, which is
+            // faster when decrease-key dominates (dense graphs), or LazyMinHeap, which pushes
+            // duplicates instead of decreasing keys and skips the stale ones on pop
+            template <class PQ = MinPriorityQueue> static Graph dijkstra(const Graph& g, int s);
+            template <class PQ = MinPriorityQueue> static Graph prim(const Graph& g, int randomS);
             static Graph kruskal(const Graph& g);
+            // Workspace versions: results (hop count / distance, parent, visit order) are
+            // left in ws, and the cost is proportional to the part of the graph reached.
+            // G is Graph, GraphSnapshot, CompactGraph or CompressedGraph.
+            template <class G> static void bfs(const G& g, int s, Workspace& ws, const SearchLimits& limits = SearchLimits());
+            template <class G> static void dijkstra(const G& g, int s, Workspace& ws, const SearchLimits& limits = SearchLimits());
+            // Backward BFS: which vertices can reach t, and in how many hops
+            static void reverseBfs(const Graph& g, int t, Workspace& ws, const SearchLimits& limits = SearchLimits());
+            // Hop count of every vertex from s into level (n ints, -1 = unreachable), found one whole
+            // BFS level at a time with bitmap frontiers. Returns the number of levels.
+            static int bfsLevels(const CompactGraph& g, int s, int* level);
+            // Labels every vertex with its strongly connected component, returns how many there are
+            static int stronglyConnectedComponents(const Graph& g, int* component);
+            // Labels every vertex with its connected component (weak ones if directed), numbered
+            // in order of their smallest vertex; returns how many there are. Union-find over the edges.
+            static int connectedComponents(const Graph& g, int* component);
+            // Same labels, computed by numThreads threads (0 = hardware concurrency)
+            static int parallelConnectedComponents(const CompactGraph& g, int* component, int numThreads = 0,
+                                                   ComponentStrategy strategy = HOOK_AND_SHORTCUT);
+            // Runs Dijkstra from every vertex in sources (count of them) and writes one
+            // row of n distances per source into distances (count * n ints, -1 = unreachable).
+            // Sources are spread over numThreads worker threads (0 = hardware concurrency).
+            static void dijkstraBatch(const Graph& g, const int* sources, int count, int* distances, int numThreads = 0);
+            // Number of vertices adjacent to both u and v (out-neighbors if directed)
+            static int commonNeighbors(const CompactGraph& g, int u, int v);
+            // |N(u) ∩ N(v)| / |N(u) ∪ N(v)|, 0 if both have no neighbors
+            static double jaccard(const CompactGraph& g, int u, int v);
+            // Triangles of an undirected graph, counted on numThreads threads (0 = hardware concurrency).
+            // perVertex (n entries, may be null) gets the triangles through each vertex.
+            static long long countTriangles(const CompactGraph& g, long long* perVertex = nullptr, int numThreads = 0);
+            // Fills coefficients (n entries) with the local clustering coefficients, returns their average
+            static double clusteringCoefficients(const CompactGraph& g, double* coefficients, int numThreads = 0);
         private:
-        static void dfs_visit(const Graph& g, int u, bool* visited, Graph& dfsTree);     
+        static void dfs_visit(const Graph& g, int u, Bitset& visited, Graph& dfsTree);     
         static Edge* extractEdgesFromGraph(const Graph& g, int& edgeCount);
+        static void checkWorkspace(int n, int s, const Workspace& ws, const char* who);
+        static void dijkstraRow(const Graph& g, int s, int* dist, MinPriorityQueue& mpq);
     };
 }
 #endif
\ No newline at end of file
@@ -0,0 +1,185 @@
+#include "Bitset.hpp"
+#include <stdexcept>
+#include <string>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+using namespace graph;
+
+// n bits, all 0
+Bitset::Bitset(int n)
+{
+    if (n < 0)
+    {
+        throw std::invalid_argument("Bitset: negative size");
+    }
+    this->n = n;
+    wordCount = (n + 63) / 64;
+    words = new unsigned long long[wordCount];
+    clear();
+}
+
+// Destructor that frees the words
+Bitset::~Bitset()
+{
+    delete[] words;
+}
+
+// Number of bits
+int Bitset::size() const
+{
+    return n;
+}
+
+// Zeroes every word
+void Bitset::clear()
+{
+    int i = 0;
+#if defined(__AVX2__)
+    __m256i zero = _mm256_setzero_si256();
+    for (; i + 4 <= wordCount; i += 4)
+    {
+        _mm256_storeu_si256((__m256i *)(words + i), zero);
+    }
+#endif
+    for (; i < wordCount; i++)
+    {
+        words[i] = 0;
+    }
+}
+
+// Sets every bit below n, the unused high bits of the last word stay 0
+void Bitset::setAll()
+{
+    for (int i = 0; i < wordCount; i++)
+    {
+        words[i] = ~0ULL;
+    }
+    if (n % 64 != 0)
+    {
+        words[wordCount - 1] = (1ULL << (n % 64)) - 1;
+    }
+}
+
+// Population count of all words
+long long Bitset::count() const
+{
+    long long total = 0;
+    for (int i = 0; i < wordCount; i++)
+    {
+        total += __builtin_popcountll(words[i]);
+    }
+    return total;
+}
+
+// True if some bit is 1
+bool Bitset::any() const
+{
+    for (int i = 0; i < wordCount; i++)
+    {
+        if (words[i] != 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Skips whole zero words, then the lowest set bit of the first nonzero one
+int Bitset::findNext(int from) const
+{
+    if (from < 0)
+    {
+        from = 0;
+    }
+    if (from >= n)
+    {
+        return -1;
+    }
+    int w = from >> 6;
+    unsigned long long bits = words[w] & (~0ULL << (from & 63));
+    while (bits == 0)
+    {
+        if (++w == wordCount)
+        {
+            return -1;
+        }
+        bits = words[w];
+    }
+    return (w << 6) + __builtin_ctzll(bits);
+}
+
+// Throws unless both sets have the same size
+static void checkSizes(int a, int b, const char *who)
+{
+    if (a != b)
+    {
+        throw std::invalid_argument(std::string(who) + ": Bitset sizes differ");
+    }
+}
+
+// this |= other
+void Bitset::orWith(const Bitset &other)
+{
+    checkSizes(n, other.n, "orWith");
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= wordCount; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(words + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(other.words + i));
+        _mm256_storeu_si256((__m256i *)(words + i), _mm256_or_si256(a, b));
+    }
+#endif
+    for (; i < wordCount; i++)
+    {
+        words[i] |= other.words[i];
+    }
+}
+
+// this &= other
+void Bitset::andWith(const Bitset &other)
+{
+    checkSizes(n, other.n, "andWith");
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= wordCount; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(words + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(other.words + i));
+        _mm256_storeu_si256((__m256i *)(words + i), _mm256_and_si256(a, b));
+    }
+#endif
+    for (; i < wordCount; i++)
+    {
+        words[i] &= other.words[i];
+    }
+}
+
+// this &= ~other
+void Bitset::andNot(const Bitset &other)
+{
+    checkSizes(n, other.n, "andNot");
+    int i = 0;
+#if defined(__AVX2__)
+    for (; i + 4 <= wordCount; i += 4)
+    {
+        __m256i a = _mm256_loadu_si256((const __m256i *)(words + i));
+        __m256i b = _mm256_loadu_si256((const __m256i *)(other.words + i));
+        _mm256_storeu_si256((__m256i *)(words + i), _mm256_andnot_si256(b, a)); // (~b) & a
+    }
+#endif
+    for (; i < wordCount; i++)
+    {
+        words[i] &= ~other.words[i];
+    }
+}
+
+// Exchanges the words of two sets of the same size, O(1)
+void Bitset::swap(Bitset &other)
+{
+    checkSizes(n, other.n, "swap");
+    unsigned long long *tmp = words;
+    words = other.words;
+    other.words = tmp;
+}
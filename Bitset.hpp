@@ -0,0 +1,45 @@
+#ifndef _BITSET_HPP_
+#define _BITSET_HPP_
+
+namespace graph{
+
+    // Fixed-size set of bits, one per vertex, packed into 64-bit words: 8 times
+    // smaller than a bool array, so visited sets of big graphs stay in cache.
+    // Whole-set operations work a word at a time (4 words per step with AVX2
+    // when the compiler targets it). Bits past size() are always 0.
+    class Bitset{
+        private:
+            int n;
+            int wordCount;
+            unsigned long long* words;
+        public:
+            Bitset(int n); // all bits 0
+            ~Bitset();
+            Bitset(const Bitset&) = delete;
+            Bitset& operator=(const Bitset&) = delete;
+            int size() const;
+            void clear(); // all bits 0
+            void setAll(); // all bits 1
+            long long count() const; // number of 1 bits
+            bool any() const;
+            int findNext(int from) const; // first 1 bit at or after from, -1 if none
+            void orWith(const Bitset& other); // this |= other
+            void andWith(const Bitset& other); // this &= other
+            void andNot(const Bitset& other); // this &= ~other
+            void swap(Bitset& other); // exchanges contents, e.g. current and next frontier
+
+            // Hot path accessors, no bounds checks
+            bool test(int i) const { return (words[i >> 6] >> (i & 63)) & 1; }
+            void set(int i) { words[i >> 6] |= 1ULL << (i & 63); }
+            void reset(int i) { words[i >> 6] &= ~(1ULL << (i & 63)); }
+            // Sets bit i, returns whether it was already set
+            bool testAndSet(int i)
+            {
+                unsigned long long bit = 1ULL << (i & 63);
+                bool was = (words[i >> 6] & bit) != 0;
+                words[i >> 6] |= bit;
+                return was;
+            }
+    };
+}
+#endif
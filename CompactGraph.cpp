@@ -0,0 +1,362 @@
+#include "CompactGraph.hpp"
+#include <algorithm>
+using namespace graph;
+
+// Collects the edge ends of g as CSR arrays with every list sorted by neighbor id.
+// Two counting passes, first by neighbor and then (stable) by owner, so no sort is needed.
+static long long buildSortedArcs(const Graph &g, long long *&offsets, int *&neighbors, int *&weights)
+{
+    int n = g.getNumVertices();
+    Node **adj = g.getAdjList();
+    long long total = 0;
+    for (int u = 0; u < n; u++)
+    {
+        total += g.getDegree(u);
+    }
+
+    // Pass 1: group by neighbor
+    long long *byNeighbor = new long long[n + 1];
+    for (int i = 0; i <= n; i++)
+    {
+        byNeighbor[i] = 0;
+    }
+    for (int u = 0; u < n; u++)
+    {
+        for (Node *curr = adj[u]; curr != nullptr; curr = curr->next)
+        {
+            byNeighbor[curr->vertex + 1]++;
+        }
+    }
+    for (int i = 0; i < n; i++)
+    {
+        byNeighbor[i + 1] += byNeighbor[i];
+    }
+    int *owner = new int[total];
+    int *groupedNeighbors = new int[total];
+    int *groupedWeights = new int[total];
+    for (int u = 0; u < n; u++)
+    {
+        for (Node *curr = adj[u]; curr != nullptr; curr = curr->next)
+        {
+            long long at = byNeighbor[curr->vertex]++;
+            owner[at] = u;
+            groupedNeighbors[at] = curr->vertex;
+            groupedWeights[at] = curr->weight;
+        }
+    }
+
+    // Pass 2: scatter to the owners, neighbors arrive in increasing order
+    offsets = new long long[n + 1];
+    offsets[0] = 0;
+    for (int u = 0; u < n; u++)
+    {
+        offsets[u + 1] = offsets[u] + g.getDegree(u);
+    }
+    long long *fill = byNeighbor; // reused as the write position of every owner
+    for (int u = 0; u < n; u++)
+    {
+        fill[u] = offsets[u];
+    }
+    neighbors = new int[total];
+    weights = new int[total];
+    for (long long i = 0; i < total; i++)
+    {
+        long long at = fill[owner[i]]++;
+        neighbors[at] = groupedNeighbors[i];
+        weights[at] = groupedWeights[i];
+    }
+
+    delete[] byNeighbor;
+    delete[] owner;
+    delete[] groupedNeighbors;
+    delete[] groupedWeights;
+    return total;
+}
+
+// ===== CompactGraph Implementation =====
+
+// Copies g into CSR form
+CompactGraph::CompactGraph(const Graph &g)
+{
+    n = g.getNumVertices();
+    directed = g.isDirected();
+    edgeCount = g.getEdgeCount();
+    negative = g.getIsNegative();
+    buildSortedArcs(g, offsets, neighbors, weights);
+    repeats = false;
+    for (int u = 0; u < n && !repeats; u++)
+    {
+        for (long long i = offsets[u] + 1; i < offsets[u + 1]; i++)
+        {
+            if (neighbors[i] == neighbors[i - 1])
+            {
+                repeats = true;
+                break;
+            }
+        }
+    }
+}
+
+// Destructor that frees all arrays
+CompactGraph::~CompactGraph()
+{
+    delete[] offsets;
+    delete[] neighbors;
+    delete[] weights;
+}
+
+// Getter for number of vertices
+int CompactGraph::getNumVertices() const
+{
+    return n;
+}
+
+// True if edges only go from u to v
+bool CompactGraph::isDirected() const
+{
+    return directed;
+}
+
+// True if any edge weight is negative
+bool CompactGraph::getIsNegative() const
+{
+    return negative;
+}
+
+// Getter for the number of edges
+int CompactGraph::getEdgeCount() const
+{
+    return edgeCount;
+}
+
+// Number of neighbors of u (out-degree if directed)
+int CompactGraph::getDegree(int u) const
+{
+    if (u < 0 || u >= n)
+    {
+        throw std::out_of_range("getDegree: Vertex index out of bounds");
+    }
+    return (int)(offsets[u + 1] - offsets[u]);
+}
+
+// Start of the sorted neighbor list of u
+const int *CompactGraph::getNeighbors(int u) const
+{
+    if (u < 0 || u >= n)
+    {
+        throw std::out_of_range("getNeighbors: Vertex index out of bounds");
+    }
+    return neighbors + offsets[u];
+}
+
+// True if a list holds some vertex more than once
+bool CompactGraph::hasRepeatedNeighbors() const
+{
+    return repeats;
+}
+
+// Bytes held by the offsets, the neighbors and the weights
+long long CompactGraph::getMemoryBytes() const
+{
+    return (long long)(n + 1) * sizeof(long long) + offsets[n] * 2 * (long long)sizeof(int);
+}
+
+// ===== CompressedGraph Implementation =====
+
+// Writes value as a varint at p and returns the position after it
+static unsigned char *writeVarint(unsigned char *p, unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        *p++ = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    *p++ = (unsigned char)value;
+    return p;
+}
+
+// Number of bytes writeVarint needs for value
+static int varintLength(unsigned int value)
+{
+    int length = 1;
+    while (value >= 0x80)
+    {
+        value >>= 7;
+        length++;
+    }
+    return length;
+}
+
+// Offset of u from v folded to unsigned: 0, -1, 1, -2, 2, ... become 0, 1, 2, 3, 4, ...
+static unsigned int zigzag(int v, int u)
+{
+    int d = v - u;
+    return ((unsigned int)d << 1) ^ (unsigned int)(d >> 31);
+}
+
+// Encodes g: one record per vertex with its degree, bit-packed weights and id gaps
+CompressedGraph::CompressedGraph(const Graph &g)
+{
+    n = g.getNumVertices();
+    directed = g.isDirected();
+    edgeCount = g.getEdgeCount();
+    negative = g.getIsNegative();
+    long long *offsets;
+    int *neighbors;
+    int *weights;
+    long long total = buildSortedArcs(g, offsets, neighbors, weights);
+
+    // Weights: as few bits as the range max - min needs
+    minWeight = total > 0 ? g.getMinWeight() : 0;
+    unsigned long long range = total > 0 ? (unsigned long long)((long long)g.getMaxWeight() - minWeight) : 0;
+    weightBits = 0;
+    while (weightBits < 64 && (range >> weightBits) != 0)
+    {
+        weightBits++;
+    }
+
+    // Size every record first so the stream is allocated exactly once
+    long long *start = new long long[n + 1];
+    start[0] = 0;
+    for (int u = 0; u < n; u++)
+    {
+        int degree = (int)(offsets[u + 1] - offsets[u]);
+        long long bytes = varintLength((unsigned int)degree) + weightBytes(degree);
+        for (long long i = offsets[u]; i < offsets[u + 1]; i++)
+        {
+            bytes += varintLength(i == offsets[u] ? zigzag(neighbors[i], u) : (unsigned int)(neighbors[i] - neighbors[i - 1]));
+        }
+        start[u + 1] = start[u] + bytes;
+    }
+
+    // Blocks of 64 records; a block whose last record starts 64 KB or more in is wide
+    int blocks = (n + 63) / 64;
+    blockOffsets = new long long[blocks + 1];
+    wideBlocks = new int[blocks];
+    listOffsets = new unsigned short[n];
+    wideCount = 0;
+    for (int b = 0; b < blocks; b++)
+    {
+        int last = std::min(n, 64 * b + 64) - 1;
+        blockOffsets[b] = start[64 * b];
+        wideBlocks[b] = start[last] - start[64 * b] > 0xffff ? 64 * wideCount++ : -1;
+    }
+    blockOffsets[blocks] = start[n];
+    wideOffsets = new unsigned int[64 * wideCount];
+    for (int u = 0; u < n; u++)
+    {
+        long long inBlock = start[u] - blockOffsets[u >> 6];
+        int wide = wideBlocks[u >> 6];
+        if (wide < 0)
+        {
+            listOffsets[u] = (unsigned short)inBlock;
+        }
+        else if (inBlock > 0xffffffffLL)
+        {
+            delete[] start;
+            delete[] blockOffsets;
+            delete[] wideBlocks;
+            delete[] listOffsets;
+            delete[] wideOffsets;
+            delete[] offsets;
+            delete[] neighbors;
+            delete[] weights;
+            throw std::length_error("CompressedGraph: 64 neighbor lists take more than 4 GB");
+        }
+        else
+        {
+            wideOffsets[wide + (u & 63)] = (unsigned int)inBlock;
+        }
+    }
+    long long bytes = start[n];
+    delete[] start;
+
+    data = new unsigned char[bytes];
+    for (int u = 0; u < n; u++)
+    {
+        unsigned char *p = data + (record(u) - data); // record() is read-only, the stream is not yet
+        int degree = (int)(offsets[u + 1] - offsets[u]);
+        p = writeVarint(p, (unsigned int)degree);
+        long long packedBytes = weightBytes(degree);
+        for (long long b = 0; b < packedBytes; b++)
+        {
+            p[b] = 0;
+        }
+        for (int i = 0; i < degree && weightBits > 0; i++)
+        {
+            unsigned long long value = (unsigned long long)((long long)weights[offsets[u] + i] - minWeight);
+            unsigned long long bit = (unsigned long long)i * weightBits;
+            for (int put = 0; put < weightBits; put++, bit++)
+            {
+                p[bit >> 3] |= (unsigned char)(((value >> put) & 1) << (bit & 7));
+            }
+        }
+        p += packedBytes;
+        for (long long i = offsets[u]; i < offsets[u + 1]; i++)
+        {
+            p = writeVarint(p, i == offsets[u] ? zigzag(neighbors[i], u) : (unsigned int)(neighbors[i] - neighbors[i - 1]));
+        }
+    }
+    delete[] offsets;
+    delete[] neighbors;
+    delete[] weights;
+}
+
+// Destructor that frees all arrays
+CompressedGraph::~CompressedGraph()
+{
+    delete[] blockOffsets;
+    delete[] wideBlocks;
+    delete[] listOffsets;
+    delete[] wideOffsets;
+    delete[] data;
+}
+
+// Getter for number of vertices
+int CompressedGraph::getNumVertices() const
+{
+    return n;
+}
+
+// True if edges only go from u to v
+bool CompressedGraph::isDirected() const
+{
+    return directed;
+}
+
+// True if any edge weight is negative
+bool CompressedGraph::getIsNegative() const
+{
+    return negative;
+}
+
+// Getter for the number of edges
+int CompressedGraph::getEdgeCount() const
+{
+    return edgeCount;
+}
+
+// Number of neighbors of u (out-degree if directed), the head of its record
+int CompressedGraph::getDegree(int u) const
+{
+    if (u < 0 || u >= n)
+    {
+        throw std::out_of_range("getDegree: Vertex index out of bounds");
+    }
+    const unsigned char *p = record(u);
+    return (int)readVarint(p);
+}
+
+// Bytes held by the offset arrays and the record stream
+long long CompressedGraph::getMemoryBytes() const
+{
+    int blocks = (n + 63) / 64;
+    return (long long)(blocks + 1) * sizeof(long long) + (long long)blocks * sizeof(int) + (long long)n * sizeof(unsigned short) +
+           64LL * wideCount * sizeof(unsigned int) + blockOffsets[blocks];
+}
+
+// Average memory per edge, offsets included
+double CompressedGraph::getBytesPerEdge() const
+{
+    return edgeCount == 0 ? 0.0 : (double)getMemoryBytes() / edgeCount;
+}
@@ -0,0 +1,154 @@
+#ifndef _COMPACT_GRAPH_HPP_
+#define _COMPACT_GRAPH_HPP_
+#include "Graph.hpp"
+
+namespace graph{
+
+    // Read-only CSR (compressed sparse row) copy of a Graph: the neighbors of u are
+    // neighbors[offsets[u]] .. neighbors[offsets[u + 1] - 1], sorted by vertex id.
+    // One allocation for all edges instead of one linked Node per edge end.
+    // Weights sit in their own array at the same positions, so a search that
+    // ignores them (forEachAdjacent) reads only 4 bytes per edge end.
+    class CompactGraph{
+        private:
+            int n;
+            bool directed;
+            int edgeCount;
+            bool negative;
+            long long* offsets;
+            int* neighbors;
+            int* weights;
+            bool repeats; // some list holds a vertex twice (parallel edges or a self loop)
+        public:
+            CompactGraph(const Graph& g);
+            ~CompactGraph();
+            CompactGraph(const CompactGraph&) = delete;
+            CompactGraph& operator=(const CompactGraph&) = delete;
+            int getNumVertices() const;
+            bool isDirected() const;
+            bool getIsNegative() const;
+            int getEdgeCount() const;
+            int getDegree(int u) const;
+            long long getMemoryBytes() const; // bytes used by offsets, neighbors and weights
+            const int* getNeighbors(int u) const; // the sorted list of u, getDegree(u) ids
+            bool hasRepeatedNeighbors() const; // false if every list is a set (strictly increasing)
+            // Calls f(v, w) for every edge (u, v, w), in increasing v, until f returns false
+            template <class F> bool forEachNeighbor(int u, F f) const
+            {
+                for (long long i = offsets[u]; i < offsets[u + 1]; i++)
+                {
+                    if (!f(neighbors[i], weights[i])) return false;
+                }
+                return true;
+            }
+            // Same as forEachNeighbor but calls f(v) only, the weights are never read
+            template <class F> bool forEachAdjacent(int u, F f) const
+            {
+                for (long long i = offsets[u]; i < offsets[u + 1]; i++)
+                {
+                    if (!f(neighbors[i])) return false;
+                }
+                return true;
+            }
+    };
+
+    // Read-only compressed copy of a Graph for graphs too big for CSR.
+    // Every vertex has one record in a byte stream: its degree, then its weights
+    // (as weight - minWeight, in just as many bits as the largest one needs, none
+    // if all are equal), then its sorted neighbor ids as varints (7 bits per
+    // byte, high bit = more). The first id is stored relative to the vertex
+    // itself, the others as gaps, so a well ordered graph needs about one byte
+    // per edge end. Records are found through one 8-byte offset per 64 vertices
+    // plus a 2-byte offset per vertex inside its block; only blocks longer than
+    // 64 KB (hubs) keep 4-byte offsets instead.
+    class CompressedGraph{
+        private:
+            int n;
+            bool directed;
+            int edgeCount;
+            bool negative;
+            long long* blockOffsets;      // record of vertex 64 * b starts at data[blockOffsets[b]]
+            int* wideBlocks;              // -1, or where the 64 offsets of block b start in wideOffsets
+            unsigned short* listOffsets;  // record of u starts listOffsets[u] bytes after its block
+            unsigned int* wideOffsets;    // the same for blocks too long for 16 bits
+            int wideCount;
+            unsigned char* data;
+            int weightBits;
+            int minWeight;
+            const unsigned char* record(int u) const
+            {
+                int wide = wideBlocks[u >> 6];
+                return data + blockOffsets[u >> 6] + (wide < 0 ? listOffsets[u] : wideOffsets[wide + (u & 63)]);
+            }
+            long long weightBytes(int degree) const { return ((long long)degree * weightBits + 7) / 8; }
+            static unsigned int readVarint(const unsigned char*& p)
+            {
+                unsigned int value = *p & 0x7f;
+                int shift = 7;
+                while (*p++ & 0x80)
+                {
+                    value |= (unsigned int)(*p & 0x7f) << shift;
+                    shift += 7;
+                }
+                return value;
+            }
+            // Weight number i of a record whose weights start at w
+            int readWeight(const unsigned char* w, int i) const
+            {
+                if (weightBits == 0) return minWeight;
+                unsigned long long bit = (unsigned long long)i * weightBits;
+                unsigned long long value = 0;
+                for (int got = 0; got < weightBits; )
+                {
+                    int shift = (int)(bit & 7);
+                    int take = 8 - shift < weightBits - got ? 8 - shift : weightBits - got;
+                    value |= (unsigned long long)((w[bit >> 3] >> shift) & ((1 << take) - 1)) << got;
+                    got += take;
+                    bit += take;
+                }
+                return (int)((long long)minWeight + (long long)value);
+            }
+            // Decodes the ids of a record, starting after the degree and the weights
+            template <class F> static bool decodeIds(int u, const unsigned char* p, int degree, F f)
+            {
+                if (degree == 0) return true;
+                unsigned int first = readVarint(p);
+                int v = u + ((int)(first >> 1) ^ -(int)(first & 1)); // zigzag: 0, -1, 1, -2, 2, ...
+                if (!f(v, 0)) return false;
+                for (int i = 1; i < degree; i++)
+                {
+                    v += (int)readVarint(p);
+                    if (!f(v, i)) return false;
+                }
+                return true;
+            }
+        public:
+            CompressedGraph(const Graph& g);
+            ~CompressedGraph();
+            CompressedGraph(const CompressedGraph&) = delete;
+            CompressedGraph& operator=(const CompressedGraph&) = delete;
+            int getNumVertices() const;
+            bool isDirected() const;
+            bool getIsNegative() const;
+            int getEdgeCount() const;
+            int getDegree(int u) const;
+            long long getMemoryBytes() const; // bytes used by all arrays
+            double getBytesPerEdge() const;
+            // Decodes the list of u, calling f(v, w) in increasing v until f returns false
+            template <class F> bool forEachNeighbor(int u, F f) const
+            {
+                const unsigned char* p = record(u);
+                int degree = (int)readVarint(p);
+                const unsigned char* w = p;
+                return decodeIds(u, p + weightBytes(degree), degree, [&](int v, int i) { return f(v, readWeight(w, i)); });
+            }
+            // Decodes the list of u, calling f(v) only; the weights are skipped, not read
+            template <class F> bool forEachAdjacent(int u, F f) const
+            {
+                const unsigned char* p = record(u);
+                int degree = (int)readVarint(p);
+                return decodeIds(u, p + weightBytes(degree), degree, [&](int v, int) { return f(v); });
+            }
+    };
+}
+#endif
@@ -1,17 +1,23 @@
 #include "DataStructures.hpp"
+#include <stdexcept>
+#include <string>
 
 namespace graph
 {
 
     // ===== Queue Implementation =====
 
-    // Constructor for a fixed-size circular queue
+    // Constructor, the capacity is rounded up to a power of two
     Queue::Queue(int cap)
     {
-        capacity = cap;
+        capacity = 1;
+        while (capacity < cap)
+        {
+            capacity *= 2;
+        }
+        mask = capacity - 1;
         arr = new int[capacity];
         frontIndex = 0;
-        rearIndex = -1;
         size = 0;
     }
 
@@ -21,70 +27,161 @@ namespace graph
         delete[] arr;
     }
 
-    // Returns true if the queue is empty
-    bool Queue::isEmpty() const
+    // Doubles the buffer until needed values fit, unwrapping the contents to the front
+    void Queue::grow(int needed)
     {
-        return size == 0;
+        int newCapacity = capacity;
+        while (newCapacity < needed)
+        {
+            newCapacity *= 2;
+        }
+        int *bigger = new int[newCapacity];
+        for (int i = 0; i < size; i++)
+        {
+            bigger[i] = arr[(frontIndex + i) & mask];
+        }
+        delete[] arr;
+        arr = bigger;
+        capacity = newCapacity;
+        mask = newCapacity - 1;
+        frontIndex = 0;
     }
 
-    // Returns true if the queue is full
-    bool Queue::isFull() const
+    // Checks if the queue contains a specific value
+    bool Queue::contains(int val) const
     {
-        return size == capacity;
+        for (int i = 0; i < size; i++)
+        {
+            if (arr[(frontIndex + i) & mask] == val)
+            {
+                return true;
+            }
+        }
+        return false;
     }
 
-    // Adds a value to the end of the queue
-    void Queue::enqueue(int val)
+    // Empties the queue without touching the stored values
+    void Queue::clear()
     {
-        if (isFull())
+        frontIndex = 0;
+        size = 0;
+    }
+
+    // Enqueues a whole span, growing at most once and copying in at most two runs
+    void Queue::pushBulk(const int *values, int count)
+    {
+        if (count < 0)
         {
-            std::cout << "Queue is full!" << std::endl;
-            return;
+            throw std::invalid_argument("pushBulk: negative count");
         }
-        rearIndex = (rearIndex + 1) % capacity;
-        arr[rearIndex] = val;
-        size++;
+        if (size + count > capacity)
+        {
+            grow(size + count);
+        }
+        int rear = (frontIndex + size) & mask;
+        int first = count < capacity - rear ? count : capacity - rear; // up to the end of the buffer
+        for (int i = 0; i < first; i++)
+        {
+            arr[rear + i] = values[i];
+        }
+        for (int i = first; i < count; i++)
+        {
+            arr[i - first] = values[i];
+        }
+        size += count;
     }
 
-    // Removes and returns the value from the front of the queue
-    int Queue::dequeue()
+    // Dequeues up to max values in order, returns how many were taken
+    int Queue::popBulk(int *out, int max)
     {
-        if (isEmpty())
+        if (max < 0)
         {
-            std::cout << "Queue is empty!" << std::endl;
-            return -1;
+            throw std::invalid_argument("popBulk: negative count");
         }
-        int val = arr[frontIndex];
-        frontIndex = (frontIndex + 1) % capacity;
-        size--;
-        return val;
+        int count = max < size ? max : size;
+        for (int i = 0; i < count; i++)
+        {
+            out[i] = arr[(frontIndex + i) & mask];
+        }
+        frontIndex = (frontIndex + count) & mask;
+        size -= count;
+        return count;
     }
 
-    // Checks if the queue contains a specific value
-    bool Queue::contains(int val) const
+    // ===== IndexedQueue Implementation =====
+
+    // Empty queue for ids 0..n-1; the ring buffer never has to hold more than n
+    IndexedQueue::IndexedQueue(int n) : queue(n)
     {
-        for (int i = 0, index = frontIndex; i < size; i++, index = (index + 1) % capacity)
+        this->n = n;
+        queued = new unsigned char[n];
+        for (int i = 0; i < n; i++)
         {
-            if (arr[index] == val)
-            {
-                return true;
-            }
+            queued[i] = 0;
+        }
+    }
+
+    // Destructor that frees the membership map
+    IndexedQueue::~IndexedQueue()
+    {
+        delete[] queued;
+    }
+
+    // Adds v at the back unless it is already waiting
+    bool IndexedQueue::enqueue(int v)
+    {
+        if (v < 0 || v >= n)
+        {
+            throw std::out_of_range("enqueue: Vertex index out of bounds");
+        }
+        if (queued[v])
+        {
+            return false;
+        }
+        queued[v] = 1;
+        queue.enqueue(v);
+        return true;
+    }
+
+    // Removes and returns the front id, which may then be queued again
+    int IndexedQueue::dequeue()
+    {
+        int v = queue.dequeue();
+        queued[v] = 0;
+        return v;
+    }
+
+    // True if v is waiting in the queue
+    bool IndexedQueue::contains(int v) const
+    {
+        if (v < 0 || v >= n)
+        {
+            throw std::out_of_range("contains: Vertex index out of bounds");
+        }
+        return queued[v] != 0;
+    }
+
+    // Empties the queue, unmarking only the ids that were in it
+    void IndexedQueue::clear()
+    {
+        while (!queue.isEmpty())
+        {
+            queued[queue.dequeue()] = 0;
         }
-        return false;
     }
 
     // ===== UnionFind Implementation =====
 
-    // Constructor that initializes each element as its own set
-    UnionFind::UnionFind(int n)
+    // Constructor that initializes each element as its own set of size 1
+    UnionFind::UnionFind(int n, PathCompression compression)
     {
         size = n;
+        sets = n;
+        this->compression = compression;
         parent = new int[size];
-        rank = new int[size];
         for (int i = 0; i < size; i++)
         {
-            parent[i] = i;
-            rank[i] = 0;
+            parent[i] = -1;
         }
     }
 
@@ -92,47 +189,460 @@ namespace graph
     UnionFind::~UnionFind()
     {
         delete[] parent;
-        delete[] rank;
     }
 
-    // Finds the representative of the set that x belongs to
+    // Finds the representative of the set that x belongs to, shortening the path on the way
     int UnionFind::find(int x)
     {
-        if (parent[x] != x)
+        if (x < 0 || x >= size)
+        {
+            throw std::out_of_range("find: Element index out of bounds");
+        }
+        if (compression == FULL)
         {
-            parent[x] = find(parent[x]); // path compression
+            int root = x;
+            while (parent[root] >= 0)
+            {
+                root = parent[root];
+            }
+            while (x != root)
+            {
+                int next = parent[x];
+                parent[x] = root;
+                x = next;
+            }
+            return root;
         }
-        return parent[x];
+        while (parent[x] >= 0)
+        {
+            int p = parent[x];
+            if (parent[p] < 0)
+            {
+                return p;
+            }
+            parent[x] = parent[p];
+            x = compression == HALVING ? parent[p] : p;
+        }
+        return x;
     }
 
-    // Unites the sets that contain x and y
-    void UnionFind::unite(int x, int y)
+    // Unites the sets that contain x and y, hanging the smaller set under the larger
+    bool UnionFind::unite(int x, int y)
     {
         int rootX = find(x);
         int rootY = find(y);
+        if (rootX == rootY)
+        {
+            return false;
+        }
+        if (parent[rootX] > parent[rootY]) // sizes are negative: rootX holds fewer
+        {
+            int tmp = rootX;
+            rootX = rootY;
+            rootY = tmp;
+        }
+        parent[rootX] += parent[rootY];
+        parent[rootY] = rootX;
+        sets--;
+        return true;
+    }
+
+    // Returns true if x and y are in the same set
+    bool UnionFind::connected(int x, int y)
+    {
+        return find(x) == find(y);
+    }
+
+    // Size of the set of x, kept at its root
+    int UnionFind::componentSize(int x)
+    {
+        return -parent[find(x)];
+    }
+
+    // Number of disjoint sets left
+    int UnionFind::componentCount() const
+    {
+        return sets;
+    }
+
+    // ===== ConcurrentUnionFind Implementation =====
+
+    // Constructor that initializes each element as its own set
+    ConcurrentUnionFind::ConcurrentUnionFind(int n)
+    {
+        size = n;
+        parent = new std::atomic<int>[size];
+        sizes = new std::atomic<int>[size];
+        for (int i = 0; i < size; i++)
+        {
+            parent[i].store(i, std::memory_order_relaxed);
+            sizes[i].store(1, std::memory_order_relaxed);
+        }
+        sets.store(n, std::memory_order_relaxed);
+    }
+
+    // Destructor that frees the memory
+    ConcurrentUnionFind::~ConcurrentUnionFind()
+    {
+        delete[] parent;
+        delete[] sizes;
+    }
+
+    // Walks up to the root with path halving: the current element is pointed at its
+    // grandparent and the walk continues from that grandparent, so every other element
+    // on the path is shortened. A failed CAS only means another thread moved x higher
+    // first, so it is not retried; the grandparent is still an ancestor of x either way.
+    int ConcurrentUnionFind::find(int x)
+    {
+        if (x < 0 || x >= size)
+        {
+            throw std::out_of_range("find: Element index out of bounds");
+        }
+        int p = parent[x].load(std::memory_order_acquire);
+        while (p != x)
+        {
+            int grand = parent[p].load(std::memory_order_acquire);
+            if (grand == p)
+            {
+                return p;
+            }
+            parent[x].compare_exchange_weak(p, grand, std::memory_order_release, std::memory_order_relaxed);
+            x = grand;
+            p = parent[x].load(std::memory_order_acquire);
+        }
+        return x;
+    }
+
+    // Links the larger root under the smaller one. The CAS fails if that root was
+    // linked by another thread in the meantime; then both roots are looked up again.
+    bool ConcurrentUnionFind::unite(int x, int y)
+    {
+        while (true)
+        {
+            int rootX = find(x);
+            int rootY = find(y);
+            if (rootX == rootY)
+            {
+                return false;
+            }
+            if (rootX < rootY)
+            {
+                int tmp = rootX;
+                rootX = rootY;
+                rootY = tmp;
+            }
+            int expected = rootX;
+            if (parent[rootX].compare_exchange_strong(expected, rootY))
+            {
+                sets.fetch_sub(1);
+                moveSize(rootX);
+                return true;
+            }
+        }
+    }
 
-        if (rootX != rootY)
+    // Moves the size held by the linked element x up to its root. If that root is
+    // linked too before the size arrives, whoever sees it linked first (its linker
+    // or this loop) takes the size from it and carries it further, so no size is
+    // lost or counted twice and all of it sits at roots once the unites are done.
+    void ConcurrentUnionFind::moveSize(int x)
+    {
+        while (parent[x].load() != x)
         {
-            if (rank[rootX] < rank[rootY])
+            int moved = sizes[x].exchange(0);
+            if (moved == 0)
             {
-                parent[rootX] = rootY;
+                return;
             }
-            else if (rank[rootX] > rank[rootY])
+            x = find(x);
+            sizes[x].fetch_add(moved);
+        }
+    }
+
+    // Checks if x and y are in the same set. Two different roots are only an
+    // answer if the first one is still a root afterwards, else it is asked again.
+    bool ConcurrentUnionFind::connected(int x, int y)
+    {
+        while (true)
+        {
+            int rootX = find(x);
+            int rootY = find(y);
+            if (rootX == rootY)
             {
-                parent[rootY] = rootX;
+                return true;
+            }
+            if (parent[rootX].load(std::memory_order_acquire) == rootX)
+            {
+                return false;
+            }
+        }
+    }
+
+    // Size of the set of x, kept at its root
+    int ConcurrentUnionFind::componentSize(int x)
+    {
+        return sizes[find(x)].load();
+    }
+
+    // Number of disjoint sets left
+    int ConcurrentUnionFind::componentCount() const
+    {
+        return sets.load();
+    }
+
+    // ===== LinkCutTree Implementation =====
+
+    // n single-node trees, every value 0
+    LinkCutTree::LinkCutTree(int n)
+    {
+        this->n = n;
+        left = new int[n];
+        right = new int[n];
+        parent = new int[n];
+        flipped = new bool[n];
+        value = new int[n];
+        best = new int[n];
+        stack = new int[n];
+        for (int i = 0; i < n; i++)
+        {
+            left[i] = -1;
+            right[i] = -1;
+            parent[i] = -1;
+            flipped[i] = false;
+            value[i] = 0;
+            best[i] = i;
+        }
+    }
+
+    // Destructor that frees the memory
+    LinkCutTree::~LinkCutTree()
+    {
+        delete[] left;
+        delete[] right;
+        delete[] parent;
+        delete[] flipped;
+        delete[] value;
+        delete[] best;
+        delete[] stack;
+    }
+
+    // Throws if x is not a node
+    void LinkCutTree::checkNode(int x, const char *who) const
+    {
+        if (x < 0 || x >= n)
+        {
+            throw std::out_of_range(std::string(who) + ": Node index out of bounds");
+        }
+    }
+
+    // True if x is the root of its splay tree (its parent link is a path-parent)
+    bool LinkCutTree::isSplayRoot(int x) const
+    {
+        int p = parent[x];
+        return p == -1 || (left[p] != x && right[p] != x);
+    }
+
+    // Recomputes best[x] from its children
+    void LinkCutTree::pull(int x)
+    {
+        best[x] = x;
+        if (left[x] != -1 && value[best[left[x]]] > value[best[x]])
+        {
+            best[x] = best[left[x]];
+        }
+        if (right[x] != -1 && value[best[right[x]]] > value[best[x]])
+        {
+            best[x] = best[right[x]];
+        }
+    }
+
+    // Applies a pending reversal of x to its children
+    void LinkCutTree::push(int x)
+    {
+        if (flipped[x])
+        {
+            int tmp = left[x];
+            left[x] = right[x];
+            right[x] = tmp;
+            if (left[x] != -1)
+            {
+                flipped[left[x]] = !flipped[left[x]];
+            }
+            if (right[x] != -1)
+            {
+                flipped[right[x]] = !flipped[right[x]];
+            }
+            flipped[x] = false;
+        }
+    }
+
+    // Moves x one level up in its splay tree
+    void LinkCutTree::rotate(int x)
+    {
+        int p = parent[x];
+        int g = parent[p];
+        if (!isSplayRoot(p))
+        {
+            if (left[g] == p)
+            {
+                left[g] = x;
             }
             else
             {
-                parent[rootY] = rootX;
-                rank[rootX]++;
+                right[g] = x;
+            }
+        }
+        parent[x] = g;
+        if (left[p] == x)
+        {
+            left[p] = right[x];
+            if (right[x] != -1)
+            {
+                parent[right[x]] = p;
             }
+            right[x] = p;
         }
+        else
+        {
+            right[p] = left[x];
+            if (left[x] != -1)
+            {
+                parent[left[x]] = p;
+            }
+            left[x] = p;
+        }
+        parent[p] = x;
+        pull(p);
+        pull(x);
     }
 
-    // Returns true if x and y are in the same set
-    bool UnionFind::connected(int x, int y)
+    // Makes x the root of its splay tree. Pending reversals on the way are
+    // pushed down first, top to bottom, with an explicit stack.
+    void LinkCutTree::splay(int x)
     {
-        return find(x) == find(y);
+        int top = 0;
+        stack[top++] = x;
+        for (int y = x; !isSplayRoot(y); y = parent[y])
+        {
+            stack[top++] = parent[y];
+        }
+        while (top > 0)
+        {
+            push(stack[--top]);
+        }
+        while (!isSplayRoot(x))
+        {
+            int p = parent[x];
+            if (!isSplayRoot(p))
+            {
+                int g = parent[p];
+                rotate((left[g] == p) == (left[p] == x) ? p : x); // zig-zig or zig-zag
+            }
+            rotate(x);
+        }
+    }
+
+    // Makes the path from the tree root to x preferred, with x at the splay root
+    void LinkCutTree::access(int x)
+    {
+        int last = -1;
+        for (int y = x; y != -1; y = parent[y])
+        {
+            splay(y);
+            right[y] = last;
+            pull(y);
+            last = y;
+        }
+        splay(x);
+    }
+
+    // Sets the value of x
+    void LinkCutTree::setValue(int x, int v)
+    {
+        checkNode(x, "setValue");
+        access(x);
+        value[x] = v;
+        pull(x);
+    }
+
+    // Value of x
+    int LinkCutTree::getValue(int x) const
+    {
+        checkNode(x, "getValue");
+        return value[x];
+    }
+
+    // Reverses the root path of x, so x becomes the root
+    void LinkCutTree::makeRoot(int x)
+    {
+        checkNode(x, "makeRoot");
+        access(x);
+        flipped[x] = !flipped[x];
+    }
+
+    // Root of the tree of x: the shallowest node of its root path
+    int LinkCutTree::findRoot(int x)
+    {
+        checkNode(x, "findRoot");
+        access(x);
+        push(x);
+        while (left[x] != -1)
+        {
+            x = left[x];
+            push(x);
+        }
+        splay(x);
+        return x;
+    }
+
+    // True if x and y are in the same tree
+    bool LinkCutTree::connected(int x, int y)
+    {
+        return x == y || findRoot(x) == findRoot(y);
+    }
+
+    // Hangs the tree of x (rerooted at x) under y
+    void LinkCutTree::link(int x, int y)
+    {
+        if (connected(x, y))
+        {
+            throw std::logic_error("link: nodes are already in the same tree");
+        }
+        makeRoot(x);
+        parent[x] = y;
+    }
+
+    // With x as the root and y accessed, the edge x-y exists exactly when
+    // x is the left child of y and has nothing to its right
+    void LinkCutTree::cut(int x, int y)
+    {
+        checkNode(y, "cut");
+        makeRoot(x);
+        access(y);
+        if (left[y] != x)
+        {
+            throw std::logic_error("cut: no tree edge between the nodes");
+        }
+        push(x);
+        if (right[x] != -1)
+        {
+            throw std::logic_error("cut: no tree edge between the nodes");
+        }
+        left[y] = -1;
+        parent[x] = -1;
+        pull(y);
+    }
+
+    // With x as the root and y accessed, the splay tree of y is exactly the path
+    int LinkCutTree::pathMax(int x, int y)
+    {
+        if (!connected(x, y))
+        {
+            throw std::logic_error("pathMax: nodes are in different trees");
+        }
+        makeRoot(x);
+        access(y);
+        return best[y];
     }
 
     // ===== MinPriorityQueue Implementation =====
@@ -202,14 +712,22 @@ namespace graph
         }
 
         Pair min = heap[0];
-        pos[min.vertex] = -1;
         heap[0] = heap[size - 1];
         pos[heap[0].vertex] = 0;
+        pos[min.vertex] = -1; // after the move, so the last element also leaves the queue
         size--;
         heapifyDown(0);
         return min;
     }
 
+    // Empties the queue, only resetting positions of the vertices still inside
+    void MinPriorityQueue::clear()
+    {
+        for (int i = 0; i < size; i++)
+            pos[heap[i].vertex] = -1;
+        size = 0;
+    }
+
     // Swaps two elements in the heap and updates their positions
     void MinPriorityQueue::swap(int i, int j)
     {
@@ -249,6 +767,335 @@ namespace graph
         }
     }
 
+    // ===== PairingHeap Implementation =====
+
+    // Constructor that allocates one node per vertex up front
+    PairingHeap::PairingHeap(int n)
+    {
+        key = new int[n];
+        child = new int[n];
+        sibling = new int[n];
+        prev = new int[n];
+        inHeap = new bool[n];
+        scratch = new int[n];
+        for (int i = 0; i < n; i++)
+            inHeap[i] = false;
+        root = -1;
+        size = 0;
+    }
+
+    // Destructor that releases the node pool
+    PairingHeap::~PairingHeap()
+    {
+        delete[] key;
+        delete[] child;
+        delete[] sibling;
+        delete[] prev;
+        delete[] inHeap;
+        delete[] scratch;
+    }
+
+    // Checks if the heap is empty
+    bool PairingHeap::isEmpty() const
+    {
+        return size == 0;
+    }
+
+    // Checks if a vertex is already in the heap
+    bool PairingHeap::contains(int vertex) const
+    {
+        return inHeap[vertex];
+    }
+
+    // Links two detached trees, the larger root becomes the first child of the smaller
+    int PairingHeap::meld(int a, int b)
+    {
+        if (key[b] < key[a])
+        {
+            int temp = a;
+            a = b;
+            b = temp;
+        }
+        sibling[b] = child[a];
+        if (child[a] != -1)
+            prev[child[a]] = b;
+        prev[b] = a;
+        child[a] = b;
+        return a;
+    }
+
+    // Inserts a vertex with its distance as a one node tree melded with the root
+    void PairingHeap::insert(int vertex, int distance)
+    {
+        if (inHeap[vertex])
+        {
+            std::cerr << "Error: vertex already in queue\n";
+            return;
+        }
+        key[vertex] = distance;
+        child[vertex] = sibling[vertex] = prev[vertex] = -1;
+        inHeap[vertex] = true;
+        root = root == -1 ? vertex : meld(root, vertex);
+        size++;
+    }
+
+    // Lowers the distance of a vertex: its subtree is cut out and melded with the root
+    void PairingHeap::decreaseKey(int vertex, int newDistance)
+    {
+        if (!inHeap[vertex] || key[vertex] <= newDistance)
+            return;
+
+        key[vertex] = newDistance;
+        if (vertex == root)
+            return;
+        int p = prev[vertex];
+        if (child[p] == vertex)
+            child[p] = sibling[vertex];
+        else
+            sibling[p] = sibling[vertex];
+        if (sibling[vertex] != -1)
+            prev[sibling[vertex]] = p;
+        sibling[vertex] = prev[vertex] = -1;
+        root = meld(root, vertex);
+    }
+
+    // Removes the root, then pairs its children left to right and melds the pairs right to left
+    Pair PairingHeap::extractMin()
+    {
+        if (isEmpty())
+        {
+            std::cerr << "Queue underflow\n";
+            return {-1, -1};
+        }
+
+        int min = root;
+        int count = 0;
+        int c = child[min];
+        while (c != -1)
+        {
+            int a = c;
+            int b = sibling[a];
+            c = b == -1 ? -1 : sibling[b];
+            sibling[a] = prev[a] = -1;
+            if (b != -1)
+            {
+                sibling[b] = prev[b] = -1;
+                a = meld(a, b);
+            }
+            scratch[count++] = a;
+        }
+        root = -1;
+        if (count > 0)
+        {
+            root = scratch[count - 1];
+            for (int i = count - 2; i >= 0; i--)
+                root = meld(scratch[i], root);
+        }
+        inHeap[min] = false;
+        size--;
+        return {min, key[min]};
+    }
+
+    // Empties the heap, walking the trees to reset only the vertices still inside
+    void PairingHeap::clear()
+    {
+        int top = 0;
+        if (root != -1)
+            scratch[top++] = root;
+        while (top > 0)
+        {
+            int x = scratch[--top];
+            inHeap[x] = false;
+            if (child[x] != -1)
+                scratch[top++] = child[x];
+            if (sibling[x] != -1)
+                scratch[top++] = sibling[x];
+        }
+        root = -1;
+        size = 0;
+    }
+
+    // ===== LazyMinHeap Implementation =====
+
+    // Constructor with room for n entries before the first growth
+    LazyMinHeap::LazyMinHeap(int n)
+    {
+        capacity = n > 0 ? n : 1;
+        size = 0;
+        heap = new Pair[capacity];
+    }
+
+    // Destructor that releases the heap array
+    LazyMinHeap::~LazyMinHeap()
+    {
+        delete[] heap;
+    }
+
+    // Doubles the array, used when duplicates fill it
+    void LazyMinHeap::grow()
+    {
+        Pair *bigger = new Pair[capacity * 2];
+        for (int i = 0; i < size; i++)
+            bigger[i] = heap[i];
+        delete[] heap;
+        heap = bigger;
+        capacity *= 2;
+    }
+
+    // Checks if no entry is left, stale or not
+    bool LazyMinHeap::isEmpty() const
+    {
+        return size == 0;
+    }
+
+    // Never true: a vertex is simply inserted again
+    bool LazyMinHeap::contains(int) const
+    {
+        return false;
+    }
+
+    // Adds an entry, moving the hole up instead of swapping at every level
+    void LazyMinHeap::insert(int vertex, int distance)
+    {
+        if (size == capacity)
+            grow();
+        int i = size++;
+        while (i > 0 && distance < heap[(i - 1) / 2].distance)
+        {
+            heap[i] = heap[(i - 1) / 2];
+            i = (i - 1) / 2;
+        }
+        heap[i] = {vertex, distance};
+    }
+
+    // The old entry stays and turns stale once the new one comes out first
+    void LazyMinHeap::decreaseKey(int vertex, int newDistance)
+    {
+        insert(vertex, newDistance);
+    }
+
+    // Removes and returns the smallest entry; the last one sinks from the top through a hole
+    Pair LazyMinHeap::extractMin()
+    {
+        if (isEmpty())
+        {
+            std::cerr << "Queue underflow\n";
+            return {-1, -1};
+        }
+
+        Pair min = heap[0];
+        Pair last = heap[--size];
+        int i = 0;
+        while (2 * i + 1 < size)
+        {
+            int smallest = 2 * i + 1;
+            if (smallest + 1 < size && heap[smallest + 1].distance < heap[smallest].distance)
+                smallest++;
+            if (heap[smallest].distance >= last.distance)
+                break;
+            heap[i] = heap[smallest];
+            i = smallest;
+        }
+        heap[i] = last;
+        return min;
+    }
+
+    // Drops every entry, nothing per vertex to reset
+    void LazyMinHeap::clear()
+    {
+        size = 0;
+    }
+
+    // Number of entries, stale ones included
+    int LazyMinHeap::getSize() const
+    {
+        return size;
+    }
+
+    // ===== Workspace Implementation =====
+
+    // Allocates all buffers once; generation starts at 1 so no stamp matches yet
+    Workspace::Workspace(int n) : queue(n), heap(n)
+    {
+        this->n = n;
+        dist = new int[n];
+        parent = new int[n];
+        stamp = new unsigned int[n];
+        settledStamp = new unsigned int[n];
+        visitedOrder = new int[n];
+        for (int i = 0; i < n; i++)
+        {
+            stamp[i] = 0;
+            settledStamp[i] = 0;
+        }
+        generation = 1;
+        visitedCount = 0;
+    }
+
+    // Destructor that frees the buffers
+    Workspace::~Workspace()
+    {
+        delete[] dist;
+        delete[] parent;
+        delete[] stamp;
+        delete[] settledStamp;
+        delete[] visitedOrder;
+    }
+
+    // Starts a new query by moving to the next generation.
+    // Only when the counter wraps around are the stamps really cleared.
+    // A query that stopped early may have left vertices in the queues, drop them too.
+    void Workspace::reset()
+    {
+        visitedCount = 0;
+        queue.clear();
+        heap.clear();
+        generation++;
+        if (generation == 0)
+        {
+            for (int i = 0; i < n; i++)
+            {
+                stamp[i] = 0;
+                settledStamp[i] = 0;
+            }
+            generation = 1;
+        }
+    }
+
+    // Number of vertices the workspace was sized for
+    int Workspace::getNumVertices() const
+    {
+        return n;
+    }
+
+    // Number of vertices settled by the last query
+    int Workspace::getVisitedCount() const
+    {
+        return visitedCount;
+    }
+
+    // The i-th vertex settled by the last query
+    int Workspace::getVisited(int i) const
+    {
+        if (i < 0 || i >= visitedCount)
+        {
+            throw std::out_of_range("Workspace: visited index out of bounds");
+        }
+        return visitedOrder[i];
+    }
+
+    // Queue used by BFS
+    Queue &Workspace::getQueue()
+    {
+        return queue;
+    }
+
+    // Priority queue used by Dijkstra
+    MinPriorityQueue &Workspace::getHeap()
+    {
+        return heap;
+    }
+
     // Sorts the edges array in ascending order using selection sort
     void selectionSort(Edge *edges, int size)
     {
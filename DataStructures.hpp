@@ -2,41 +2,132 @@
 #define _DATA_STRUCTURES_
 
 #include <iostream>
+#include <atomic>
+#include <stdexcept>
+#include "Bitset.hpp"
 
 namespace graph {
 
     // ===== Queue =====
+    // Ring buffer whose capacity is a power of two, so positions wrap with a
+    // mask instead of %. It doubles when full, so nothing is ever dropped.
     class Queue {
     private:
         int* arr;
         int capacity;
+        int mask;      // capacity - 1
         int frontIndex;
-        int rearIndex;
         int size;
+        void grow(int needed);
 
     public:
-        Queue(int cap);
+        Queue(int cap = 16); // room for at least cap values before the first growth
         ~Queue();
-        bool isEmpty() const;
-        bool isFull() const;
-        void enqueue(int val);
-        int dequeue();
+        Queue(const Queue&) = delete;
+        Queue& operator=(const Queue&) = delete;
+        bool isEmpty() const { return size == 0; }
+        bool isFull() const { return size == capacity; } // the next enqueue grows the buffer
+        int getSize() const { return size; }
+        int getCapacity() const { return capacity; }
         bool contains(int val) const;
+        void clear();
+        void pushBulk(const int* values, int count); // enqueues values[0..count-1] in order
+        int popBulk(int* out, int max); // dequeues up to max values into out, returns how many
+
+        // Hot path, kept inline because traversals call them per vertex
+        void enqueue(int val)
+        {
+            if (size == capacity) grow(size + 1);
+            arr[(frontIndex + size) & mask] = val;
+            size++;
+        }
+        int dequeue()
+        {
+            if (size == 0) throw std::underflow_error("dequeue: Queue is empty");
+            int val = arr[frontIndex];
+            frontIndex = (frontIndex + 1) & mask;
+            size--;
+            return val;
+        }
+    };
+
+    // ===== IndexedQueue =====
+    // FIFO of vertex ids 0..n-1 where each id is queued at most once.
+    // A byte per vertex records membership, so contains is O(1) instead of a
+    // scan; enqueue and dequeue keep it up to date. Meant for queue-based
+    // relaxation (SPFA style), where a vertex already waiting is not added again.
+    class IndexedQueue {
+    private:
+        Queue queue;
+        unsigned char* queued; // 1 while the id is in the queue
+        int n;
+
+    public:
+        IndexedQueue(int n);
+        ~IndexedQueue();
+        IndexedQueue(const IndexedQueue&) = delete;
+        IndexedQueue& operator=(const IndexedQueue&) = delete;
+        bool isEmpty() const { return queue.isEmpty(); }
+        int getSize() const { return queue.getSize(); }
+        bool enqueue(int v); // false (and nothing added) if v is already queued
+        int dequeue();
+        bool contains(int v) const;
+        void clear(); // O(size), not O(n)
     };
 
     // ===== Union-Find =====
+    // How find shortens the path it walked
+    enum PathCompression {
+        HALVING,    // every other element points at its grandparent (one pass)
+        SPLITTING,  // every element points at its grandparent (one pass)
+        FULL        // every element points at the root (two passes)
+    };
+
+    // Union by size in one packed array: parent[x] is the parent of x, or
+    // -(size of the set) when x is a root. find never recurses.
     class UnionFind {
     private:
         int* parent;
-        int* rank;
         int size;
+        int sets;
+        PathCompression compression;
 
     public:
-        UnionFind(int n);
+        UnionFind(int n, PathCompression compression = HALVING);
         ~UnionFind();
+        UnionFind(const UnionFind&) = delete;
+        UnionFind& operator=(const UnionFind&) = delete;
+        int find(int x);
+        bool unite(int x, int y); // false if x and y were already together
+        bool connected(int x, int y);
+        int componentSize(int x); // number of elements in the set of x
+        int componentCount() const; // number of sets
+    };
+
+    // ===== Concurrent Union-Find =====
+    // Same operations as UnionFind, safe to call from many threads at once.
+    // Lock-free: links and path halving are single CAS steps on the parent array.
+    // Roots are linked by index (larger under smaller), so the root of every set
+    // is its smallest element. Set sizes and the set count are exact once no
+    // unite is running; during one they may lag behind.
+    class ConcurrentUnionFind {
+    private:
+        std::atomic<int>* parent;
+        std::atomic<int>* sizes; // set size at each root, 0 once all of it moved up
+        std::atomic<int> sets;
+        int size;
+        void moveSize(int x);
+
+    public:
+        ConcurrentUnionFind(int n);
+        ~ConcurrentUnionFind();
+        ConcurrentUnionFind(const ConcurrentUnionFind&) = delete;
+        ConcurrentUnionFind& operator=(const ConcurrentUnionFind&) = delete;
         int find(int x);
-        void unite(int x, int y);
+        bool unite(int x, int y); // false if x and y were already together
         bool connected(int x, int y);
+        int componentSize(int x); // number of elements in the set of x
+        int componentCount() const; // number of sets
     };
 
     // ===== Edge struct (for Kruskal) =====
@@ -77,6 +168,164 @@ namespace graph {
         void insert(int vertex, int distance);
         void decreaseKey(int vertex, int newDistance);
         Pair extractMin();
+        void clear();
+    };
+
+    // ===== PairingHeap (addressable, for decrease-key heavy workloads) =====
+    // Same interface as MinPriorityQueue, so the algorithms can take either.
+    // decreaseKey cuts the subtree of the vertex and melds it with the root in
+    // O(1); all the restructuring is left to extractMin (two-pass pairing).
+    // Nodes are pooled: node v lives at index v of fixed arrays, so no
+    // allocation happens after construction.
+    class PairingHeap {
+    private:
+        int* key;
+        int* child;    // first child, -1 if none
+        int* sibling;  // next sibling, -1 if last
+        int* prev;     // parent for a first child, left sibling otherwise
+        bool* inHeap;
+        int* scratch;  // roots waiting to be paired, or the stack of clear()
+        int root;
+        int size;
+
+        int meld(int a, int b);
+
+    public:
+        PairingHeap(int n);
+        ~PairingHeap();
+        PairingHeap(const PairingHeap&) = delete;
+        PairingHeap& operator=(const PairingHeap&) = delete;
+
+        bool isEmpty() const;
+        bool contains(int vertex) const;
+        void insert(int vertex, int distance);
+        void decreaseKey(int vertex, int newDistance);
+        Pair extractMin();
+        void clear();
+    };
+
+    // ===== LazyMinHeap (binary heap without decrease-key) =====
+    // Same interface again, but it never tracks where a vertex sits: contains is
+    // always false, so the algorithms insert a vertex again instead of lowering
+    // its key, and decreaseKey does the same. The old entries stay behind and
+    // the caller skips them when they come out (distance above the current one,
+    // or vertex already done). No pos[] writes per swap, only one Pair array
+    // that grows when the duplicates need more room.
+    class LazyMinHeap {
+    private:
+        Pair* heap;
+        int capacity;
+        int size;
+
+        void grow();
+
+    public:
+        LazyMinHeap(int n);
+        ~LazyMinHeap();
+        LazyMinHeap(const LazyMinHeap&) = delete;
+        LazyMinHeap& operator=(const LazyMinHeap&) = delete;
+
+        bool isEmpty() const;
+        bool contains(int vertex) const; // always false, entries are never looked up
+        void insert(int vertex, int distance);
+        void decreaseKey(int vertex, int newDistance); // pushes a new entry
+        Pair extractMin();
+        void clear();
+        int getSize() const; // entries, stale ones included
+    };
+
+    // ===== LinkCutTree (for dynamic trees) =====
+    // A forest of n nodes that supports link, cut and path queries in
+    // O(log n) amortized. Every node holds a value; pathMax returns the node
+    // with the largest value on the tree path between two nodes.
+    // Each preferred path is a splay tree keyed by depth; reversals (for
+    // makeRoot) are pushed down lazily. -1 stands for "no node".
+    class LinkCutTree {
+    private:
+        int n;
+        int* left;
+        int* right;
+        int* parent;   // splay parent, or the path-parent for the root of a splay tree
+        bool* flipped; // children of the subtree still have to be swapped
+        int* value;
+        int* best;     // node with the largest value in the splay subtree
+        int* stack;    // scratch for splay
+
+        bool isSplayRoot(int x) const;
+        void pull(int x);
+        void push(int x);
+        void rotate(int x);
+        void splay(int x);
+        void access(int x);
+        void checkNode(int x, const char* who) const;
+
+    public:
+        LinkCutTree(int n);
+        ~LinkCutTree();
+        LinkCutTree(const LinkCutTree&) = delete;
+        LinkCutTree& operator=(const LinkCutTree&) = delete;
+
+        void setValue(int x, int v);
+        int getValue(int x) const;
+        void makeRoot(int x); // makes x the root of its tree
+        int findRoot(int x);
+        bool connected(int x, int y);
+        void link(int x, int y); // adds the tree edge x-y, x and y must be in different trees
+        void cut(int x, int y); // removes the tree edge x-y
+        int pathMax(int x, int y); // node with the largest value on the path from x to y
+    };
+
+    // ===== Workspace (reusable scratch buffers for Algorithms) =====
+    // Holds the per-query arrays so repeated queries on graphs of the same size
+    // allocate nothing. A vertex counts as reached only if its stamp equals the
+    // current generation, so reset() costs nothing per vertex of the graph.
+    // Reached vertices may still have a tentative distance; settled ones are final.
+    class Workspace {
+    private:
+        int n;
+        int* dist;
+        int* parent;
+        unsigned int* stamp;
+        unsigned int* settledStamp;
+        unsigned int generation;
+        int* visitedOrder;      // vertices settled by the current query, in order
+        int visitedCount;
+        Queue queue;
+        MinPriorityQueue heap;
+
+    public:
+        Workspace(int n);
+        ~Workspace();
+        Workspace(const Workspace&) = delete;
+        Workspace& operator=(const Workspace&) = delete;
+        void reset();           // forget the previous query
+        int getNumVertices() const;
+        int getVisitedCount() const;
+        int getVisited(int i) const;
+        Queue& getQueue();
+        MinPriorityQueue& getHeap();
+
+        // Hot path accessors, kept inline because traversals call them per edge
+        bool isReached(int v) const { return stamp[v] == generation; }
+        bool isSettled(int v) const { return settledStamp[v] == generation; }
+        int getDistance(int v) const { return isReached(v) ? dist[v] : -1; }
+        int getParent(int v) const { return isReached(v) ? parent[v] : -1; }
+        void reach(int v, int d, int p)
+        {
+            stamp[v] = generation;
+            dist[v] = d;
+            parent[v] = p;
+        }
+        void settle(int v)
+        {
+            settledStamp[v] = generation;
+            visitedOrder[visitedCount++] = v;
+        }
+        void update(int v, int d, int p)
+        {
+            dist[v] = d;
+            parent[v] = p;
+        }
     };
 
 }
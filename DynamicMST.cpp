@@ -0,0 +1,209 @@
+#include "DynamicMST.hpp"
+#include <limits>
+#include <stdexcept>
+using namespace graph;
+
+// Empty forest. A forest on n vertices has at most n - 1 edges, so n slots are enough.
+DynamicMST::DynamicMST(int n) : lct(2 * n)
+{
+    this->n = n;
+    g = nullptr;
+    edgeU = new int[n];
+    edgeV = new int[n];
+    edgeWeight = new int[n];
+    used = new bool[n];
+    freeSlots = new int[n];
+    freeCount = n;
+    for (int i = 0; i < n; i++)
+    {
+        used[i] = false;
+        freeSlots[i] = n - 1 - i; // slot 0 is handed out first
+    }
+    for (int v = 0; v < n; v++)
+    {
+        lct.setValue(v, std::numeric_limits<int>::min()); // vertices never win pathMax
+    }
+    forestEdges = 0;
+    totalWeight = 0;
+    stale = false;
+}
+
+// Inserts every edge of g, then listens to it
+DynamicMST::DynamicMST(Graph &g) : DynamicMST(g.getNumVertices())
+{
+    if (g.isDirected())
+    {
+        throw std::logic_error("DynamicMST requires an undirected graph.");
+    }
+    for (int u = 0; u < n; u++)
+    {
+        g.forEachNeighbor(u, [&](int v, int w) {
+            if (v > u)                   // every edge is listed at both ends
+            {
+                addEdge(u, v, w);
+            }
+            return true;
+        });
+    }
+    this->g = &g;
+    g.addListener(this);
+}
+
+// Detaches from the graph and frees the slots
+DynamicMST::~DynamicMST()
+{
+    if (g != nullptr)
+    {
+        g->removeListener(this);
+    }
+    delete[] edgeU;
+    delete[] edgeV;
+    delete[] edgeWeight;
+    delete[] used;
+    delete[] freeSlots;
+}
+
+// Puts edge (u, v, w) into a free slot and links it between u and v
+void DynamicMST::linkEdge(int u, int v, int w)
+{
+    int slot = freeSlots[--freeCount];
+    edgeU[slot] = u;
+    edgeV[slot] = v;
+    edgeWeight[slot] = w;
+    used[slot] = true;
+    lct.setValue(n + slot, w);
+    lct.link(n + slot, u);
+    lct.link(n + slot, v);
+    forestEdges++;
+    totalWeight += w;
+}
+
+// Cuts the edge in slot out of the forest and frees the slot
+void DynamicMST::cutSlot(int slot)
+{
+    lct.cut(n + slot, edgeU[slot]);
+    lct.cut(n + slot, edgeV[slot]);
+    used[slot] = false;
+    freeSlots[freeCount++] = slot;
+    forestEdges--;
+    totalWeight -= edgeWeight[slot];
+}
+
+// Adds edge (u, v, w): joins two trees, or swaps out the heaviest edge of
+// the cycle it closes if that one is heavier than w
+bool DynamicMST::addEdge(int u, int v, int w)
+{
+    if (u < 0 || u >= n || v < 0 || v >= n)
+    {
+        throw std::out_of_range("addEdge: Vertex index out of bounds");
+    }
+    if (u == v)
+    {
+        return false;                    // a self loop is never in a spanning forest
+    }
+    if (!lct.connected(u, v))
+    {
+        linkEdge(u, v, w);
+        return true;
+    }
+    int heaviest = 0;
+    int slot = heaviestOnPath(u, v, heaviest);
+    if (heaviest <= w)
+    {
+        return false;
+    }
+    cutSlot(slot);
+    linkEdge(u, v, w);
+    return true;
+}
+
+// True if u and v are in the same tree of the forest
+bool DynamicMST::connected(int u, int v)
+{
+    if (u < 0 || u >= n || v < 0 || v >= n)
+    {
+        throw std::out_of_range("connected: Vertex index out of bounds");
+    }
+    return lct.connected(u, v);
+}
+
+// Sum of the forest edge weights
+long long DynamicMST::getTotalWeight() const
+{
+    return totalWeight;
+}
+
+// Number of forest edges
+int DynamicMST::getEdgeCount() const
+{
+    return forestEdges;
+}
+
+// Slot of the heaviest forest edge between u and v (u != v, same tree).
+// -1 only if all of them weigh INT_MIN.
+int DynamicMST::heaviestOnPath(int u, int v, int &weight)
+{
+    if (u == v || !connected(u, v))
+    {
+        throw std::invalid_argument("heaviestOnPath: no forest path between the vertices");
+    }
+    int node = lct.pathMax(u, v);
+    if (node < n)
+    {
+        weight = std::numeric_limits<int>::min(); // every edge on the path weighs as little as a vertex
+        return -1;
+    }
+    weight = edgeWeight[node - n];
+    return node - n;
+}
+
+// True once the listened graph lost or reweighted an edge, or was replaced
+bool DynamicMST::isStale() const
+{
+    return stale;
+}
+
+// The forest as a new undirected graph
+Graph DynamicMST::toGraph() const
+{
+    Graph forest(n);
+    for (int slot = 0; slot < n; slot++)
+    {
+        if (used[slot])
+        {
+            forest.addEdge(edgeU[slot], edgeV[slot], edgeWeight[slot]);
+        }
+    }
+    return forest;
+}
+
+// A new edge of the listened graph. After a move into the graph it may have
+// more vertices than the forest; such an edge cannot be in it.
+void DynamicMST::onEdgeAdded(int u, int v, int w)
+{
+    if (u >= n || v >= n)
+    {
+        stale = true;
+        return;
+    }
+    addEdge(u, v, w);
+}
+
+// Removing a forest edge needs a replacement search, which this structure does not do
+void DynamicMST::onEdgeRemoved(int, int, int)
+{
+    stale = true;
+}
+
+// Only a lighter weight could be handled as an insertion, the old copy would
+// stay in the forest, so every change marks it stale
+void DynamicMST::onWeightChanged(int, int, int, int)
+{
+    stale = true;
+}
+
+// The graph was moved into, so the forest belongs to edges that are gone
+void DynamicMST::onGraphReplaced()
+{
+    stale = true;
+}
@@ -0,0 +1,52 @@
+#ifndef _DYNAMIC_MST_HPP_
+#define _DYNAMIC_MST_HPP_
+#include "Graph.hpp"
+#include "DataStructures.hpp"
+
+namespace graph{
+
+    // Minimum spanning forest kept up to date while edges are inserted, in
+    // O(log n) amortized per edge instead of a new Kruskal run.
+    // The forest lives in a link-cut tree where every forest edge is a node of
+    // its own (value = weight) between its two ends, so the heaviest edge on
+    // the path u..v is a single pathMax query. A new edge (u, v, w) either joins
+    // two trees or replaces that heaviest edge when it is lighter.
+    // Attached to a graph it follows its addEdge calls. A removal, a weight
+    // change or a move into the graph is not handled and marks the forest
+    // stale instead; edges past its vertices are then skipped.
+    class DynamicMST : public GraphListener{
+        private:
+            int n;
+            Graph* g; // the graph listened to, or nullptr
+            LinkCutTree lct; // nodes 0..n-1 are the vertices, n + i is edge slot i
+            int* edgeU; // ends and weight of the forest edge in each slot
+            int* edgeV;
+            int* edgeWeight;
+            bool* used;
+            int* freeSlots; // stack of unused slots
+            int freeCount;
+            int forestEdges;
+            long long totalWeight;
+            bool stale;
+            void linkEdge(int u, int v, int w);
+            void cutSlot(int slot);
+        public:
+            DynamicMST(int n); // forest of n vertices and no edges
+            DynamicMST(Graph& g); // starts from the edges of g and follows it; g must outlive it
+            ~DynamicMST();
+            DynamicMST(const DynamicMST&) = delete;
+            DynamicMST& operator=(const DynamicMST&) = delete;
+            bool addEdge(int u, int v, int w); // true if the forest changed
+            bool connected(int u, int v);
+            long long getTotalWeight() const;
+            int getEdgeCount() const; // edges in the forest
+            int heaviestOnPath(int u, int v, int& weight); // returns the slot, weight gets its weight
+            bool isStale() const; // an edge was removed or reweighted, or the listened graph replaced
+            Graph toGraph() const; // the forest as a graph
+            void onEdgeAdded(int u, int v, int w) override;
+            void onEdgeRemoved(int u, int v, int w) override;
+            void onWeightChanged(int u, int v, int oldWeight, int w) override;
+            void onGraphReplaced() override;
+    };
+}
+#endif
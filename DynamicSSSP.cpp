@@ -0,0 +1,330 @@
+#include "DynamicSSSP.hpp"
+#include <limits>
+#include <stdexcept>
+using namespace graph;
+
+const int DynamicSSSP::INF = std::numeric_limits<int>::max();
+
+// Checks the graph, runs the first Dijkstra and starts listening
+DynamicSSSP::DynamicSSSP(Graph &g, int s)
+{
+    n = g.getNumVertices();
+    if (s < 0 || s >= n)
+    {
+        throw std::out_of_range("DynamicSSSP: Source vertex index out of bounds");
+    }
+    this->g = &g;
+    this->s = s;
+    const char *why = unsupported();
+    if (why != nullptr)
+    {
+        throw std::logic_error(why);
+    }
+    allocate();
+    recompute();
+    g.addListener(this);
+}
+
+// Detaches from the graph and frees the arrays
+DynamicSSSP::~DynamicSSSP()
+{
+    g->removeListener(this);
+    release();
+}
+
+// Arrays and heap for n vertices
+void DynamicSSSP::allocate()
+{
+    dist = new int[n];
+    parent = new int[n];
+    affected = new bool[n];
+    affectedList = new int[n];
+    heap = new MinPriorityQueue(n);
+    for (int v = 0; v < n; v++)
+    {
+        affected[v] = false;
+    }
+}
+
+// Frees what allocate() made
+void DynamicSSSP::release()
+{
+    delete[] dist;
+    delete[] parent;
+    delete[] affected;
+    delete[] affectedList;
+    delete heap;
+}
+
+// Why the listened graph cannot be handled, or nullptr if it can
+const char *DynamicSSSP::unsupported() const
+{
+    if (g->getIsNegative())
+    {
+        return "DynamicSSSP cannot run on graphs with negative edge weights.";
+    }
+    if (g->isDirected() && !g->hasInEdges())
+    {
+        return "DynamicSSSP requires a directed graph that tracks in-edges.";
+    }
+    return nullptr;
+}
+
+// Dijkstra over the vertices already in the heap-> With onlyAffected set,
+// edges into vertices outside the affected set are skipped.
+void DynamicSSSP::propagate(bool onlyAffected)
+{
+    while (!heap->isEmpty())
+    {
+        Pair curr = heap->extractMin();
+        int x = curr.vertex;
+        touched++;
+        g->forEachNeighbor(x, [&](int y, int w) {
+            if (onlyAffected && !affected[y])
+            {
+                return true;
+            }
+            int d = curr.distance + w;
+            if (d < dist[y])
+            {
+                dist[y] = d;
+                parent[y] = x;
+                if (heap->contains(y))
+                {
+                    heap->decreaseKey(y, d);
+                }
+                else
+                {
+                    heap->insert(y, d);
+                }
+            }
+            return true;
+        });
+    }
+}
+
+// Edge u->v of weight w is new or lighter: restart Dijkstra at v if it got closer
+void DynamicSSSP::improve(int u, int v, int w)
+{
+    if (dist[u] == INF || dist[u] + w >= dist[v])
+    {
+        return;
+    }
+    dist[v] = dist[u] + w;
+    parent[v] = u;
+    heap->insert(v, dist[v]);
+    propagate(false);
+}
+
+// Edge u->v (which weighed oldWeight) is gone or heavier. Only if the tree
+// used exactly that edge does anything change.
+void DynamicSSSP::worsen(int u, int v, int oldWeight)
+{
+    if (v == s || parent[v] != u || dist[u] == INF || dist[v] != dist[u] + oldWeight)
+    {
+        return;
+    }
+    repairSubtree(v);
+}
+
+// Recomputes the shortest-path subtree below v. Distances only grew, so
+// every vertex outside the subtree keeps its distance.
+void DynamicSSSP::repairSubtree(int v)
+{
+    // Phase 1: the subtree, found by following tree edges down from v
+    int count = 0;
+    affected[v] = true;
+    affectedList[count++] = v;
+    for (int i = 0; i < count; i++)
+    {
+        int x = affectedList[i];
+        g->forEachAdjacent(x, [&](int y) {
+            if (!affected[y] && parent[y] == x)
+            {
+                affected[y] = true;
+                affectedList[count++] = y;
+            }
+            return true;
+        });
+    }
+    for (int i = 0; i < count; i++)
+    {
+        dist[affectedList[i]] = INF;
+        parent[affectedList[i]] = -1;
+    }
+
+    // Phase 2: best way in from outside the subtree, then Dijkstra inside it
+    AdjacencyView in = g->inEdgeView();
+    for (int i = 0; i < count; i++)
+    {
+        int y = affectedList[i];
+        in.forEachNeighbor(y, [&](int x, int w) {
+            if (!affected[x] && dist[x] != INF && dist[x] + w < dist[y])
+            {
+                dist[y] = dist[x] + w;
+                parent[y] = x;
+            }
+            return true;
+        });
+        if (dist[y] != INF)
+        {
+            heap->insert(y, dist[y]);
+        }
+    }
+    propagate(true);
+    touched += count;
+
+    for (int i = 0; i < count; i++)
+    {
+        affected[affectedList[i]] = false;
+    }
+}
+
+// Source vertex
+int DynamicSSSP::getSource() const
+{
+    return s;
+}
+
+// Current distance from the source
+int DynamicSSSP::getDistance(int v) const
+{
+    if (v < 0 || v >= n)
+    {
+        throw std::out_of_range("getDistance: Vertex index out of bounds");
+    }
+    return dist[v] == INF ? -1 : dist[v];
+}
+
+// Parent of v in the shortest-path tree
+int DynamicSSSP::getParent(int v) const
+{
+    if (v < 0 || v >= n)
+    {
+        throw std::out_of_range("getParent: Vertex index out of bounds");
+    }
+    return parent[v];
+}
+
+// How many vertices the last update settled or re-examined
+int DynamicSSSP::getTouchedCount() const
+{
+    return touched;
+}
+
+// True if a negative weight arrived or the graph was replaced by one that does
+// not qualify; the distances are not repaired then
+bool DynamicSSSP::isStale() const
+{
+    return stale;
+}
+
+// Dijkstra from scratch
+void DynamicSSSP::recompute()
+{
+    if (s >= n)
+    {
+        throw std::out_of_range("recompute: Source vertex index out of bounds");
+    }
+    const char *why = unsupported();
+    if (why != nullptr)
+    {
+        throw std::logic_error(why);
+    }
+    for (int v = 0; v < n; v++)
+    {
+        dist[v] = INF;
+        parent[v] = -1;
+    }
+    dist[s] = 0;
+    parent[s] = s;
+    touched = 0;
+    heap->clear();
+    heap->insert(s, 0);
+    propagate(false);
+    stale = false;
+}
+
+// New edge: may only shorten paths
+void DynamicSSSP::onEdgeAdded(int u, int v, int w)
+{
+    touched = 0;
+    if (stale || w < 0)
+    {
+        stale = true;
+        return;
+    }
+    improve(u, v, w);
+    if (!g->isDirected())
+    {
+        improve(v, u, w);
+    }
+}
+
+// Removed edge: may only lengthen paths
+void DynamicSSSP::onEdgeRemoved(int u, int v, int w)
+{
+    touched = 0;
+    if (stale)
+    {
+        return;
+    }
+    worsen(u, v, w);
+    if (!g->isDirected())
+    {
+        worsen(v, u, w);
+    }
+}
+
+// A lighter edge acts like a new one, a heavier one like a removal
+void DynamicSSSP::onWeightChanged(int u, int v, int oldWeight, int w)
+{
+    touched = 0;
+    if (stale || w < 0)
+    {
+        stale = true;
+        return;
+    }
+    if (w < oldWeight)
+    {
+        improve(u, v, w);
+        if (!g->isDirected())
+        {
+            improve(v, u, w);
+        }
+    }
+    else if (w > oldWeight)
+    {
+        worsen(u, v, oldWeight);
+        if (!g->isDirected())
+        {
+            worsen(v, u, oldWeight);
+        }
+    }
+}
+
+// The graph was moved into: the arrays follow its vertex count, then the tree is
+// computed again if the source still exists and the graph qualifies. Otherwise
+// nothing is reachable and the result stays stale (recompute() tells why).
+void DynamicSSSP::onGraphReplaced()
+{
+    touched = 0;
+    if (g->getNumVertices() != n)
+    {
+        release();
+        n = g->getNumVertices();
+        allocate();
+    }
+    if (s < n && unsupported() == nullptr)
+    {
+        recompute();
+        return;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        dist[v] = INF;
+        parent[v] = -1;
+    }
+    heap->clear();
+    stale = true;
+}
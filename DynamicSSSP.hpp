@@ -0,0 +1,56 @@
+#ifndef _DYNAMIC_SSSP_HPP_
+#define _DYNAMIC_SSSP_HPP_
+#include "Graph.hpp"
+#include "DataStructures.hpp"
+
+namespace graph{
+
+    // Shortest paths from one source, repaired after every edge change of the
+    // graph it listens to instead of rerunning Dijkstra (Ramalingam-Reps).
+    //  - a new edge or a lower weight: Dijkstra restarted from the improved end,
+    //    it only goes as far as distances keep dropping
+    //  - a removed or heavier edge of the shortest-path tree: the subtree below it
+    //    is the affected set; those vertices get their best distance through
+    //    unaffected in-neighbors and Dijkstra settles the rest inside the set
+    // Other changes cost O(1). Weights must stay non-negative; a negative one
+    // makes the result stale until recompute(). A directed graph must track
+    // in-edges. A move into the graph is answered with a full recompute, or
+    // marks it stale when the source is gone or the new graph does not qualify.
+    class DynamicSSSP : public GraphListener{
+        private:
+            Graph* g;
+            int n;
+            int s;
+            int* dist; // INF if unreachable
+            int* parent;
+            bool* affected;
+            int* affectedList;
+            MinPriorityQueue* heap;
+            bool stale;
+            int touched;
+            static const int INF;
+            void allocate();
+            void release();
+            const char* unsupported() const;
+            void propagate(bool onlyAffected);
+            void improve(int u, int v, int w);
+            void worsen(int u, int v, int oldWeight);
+            void repairSubtree(int v);
+        public:
+            DynamicSSSP(Graph& g, int s); // computes the tree and listens to g, which must outlive it
+            ~DynamicSSSP();
+            DynamicSSSP(const DynamicSSSP&) = delete;
+            DynamicSSSP& operator=(const DynamicSSSP&) = delete;
+            int getSource() const;
+            int getDistance(int v) const; // -1 if unreachable
+            int getParent(int v) const; // -1 if unreachable, s for s
+            int getTouchedCount() const; // vertices the last repair looked at
+            bool isStale() const; // a negative weight showed up, or the graph was replaced
+            void recompute(); // full Dijkstra, clears stale
+            void onEdgeAdded(int u, int v, int w) override;
+            void onEdgeRemoved(int u, int v, int w) override;
+            void onWeightChanged(int u, int v, int oldWeight, int w) override;
+            void onGraphReplaced() override;
+    };
+}
+#endif
@@ -1,20 +1,84 @@
 #include "Graph.hpp"
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
 using namespace graph;
 //adding to adjacency list the vertices
 Graph::Graph(int n)
 {
     this->n = n;
     this->adjacency_List = new Node *[n];
+    this->degree = new int[n];
     for (int i = 0; i < n; i++)
     {
         adjacency_List[i] = nullptr;
+        degree[i] = 0;
     }
 }
-// Constructor
+// Constructor for a directed graph (or undirected when directed is false).
+// With trackInEdges every vertex also keeps the list of edges coming into it,
+// which backward searches use.
+Graph::Graph(int n, bool directed, bool trackInEdges) : Graph(n)
+{
+    this->directed = directed;
+    if (directed)
+    {
+        inDegree = new int[n];
+        for (int i = 0; i < n; i++)
+        {
+            inDegree[i] = 0;
+        }
+        if (trackInEdges)
+        {
+            inAdjacency_List = new Node *[n];
+            for (int i = 0; i < n; i++)
+            {
+                inAdjacency_List[i] = nullptr;
+            }
+        }
+    }
+}
+// Constructor that adopts an array of (undirected) lists: from now on the graph
+// owns adj and its nodes and frees them. The edges are counted once.
 Graph::Graph(int n, Node **adj)
 {
     this->n = n;
     this->adjacency_List = adj;
+    this->degree = new int[n];
+    int halfEdges = 0;
+    int negativeHalfEdges = 0;
+    for (int i = 0; i < n; i++)
+    {
+        degree[i] = 0;
+        Node *curr = adj[i];
+        while (curr != nullptr)
+        {
+            degree[i]++;
+            halfEdges++;
+            if (curr->weight < 0)
+            {
+                negativeHalfEdges++;
+            }
+            curr = curr->next;
+        }
+    }
+    // every undirected edge is stored twice
+    edgeCount = halfEdges / 2;
+    negativeCount = negativeHalfEdges / 2;
+    weightBoundsStale = true;
+}
+// Puts a node for neighbor v with weight w at the front of the list of u
+Node *Graph::pushNode(Node **lists, EdgeIndex *index, int u, int v, int w)
+{
+    Node *node = new Node(v, w);
+    node->next = lists[u];
+    lists[u] = node;
+    if (index != nullptr)
+    {
+        index[u].insert(v, node);
+    }
+    return node;
 }
 void Graph::addEdge(int u, int v, int w)
 {
@@ -23,21 +87,153 @@ void Graph::addEdge(int u, int v, int w)
     {
         throw std::out_of_range("addEdge: Vertex index out of bounds");
     }
-    //Check if we add a negative edge to the graph and update the variable
+    // Create a new node for the edge and add it to the adjacency list
+    pushNode(adjacency_List, edgeIndex, u, v, w);
+    if (!directed)
+    {
+        //because the graph is undirected, we add the edge for to the other vertex too
+        pushNode(adjacency_List, edgeIndex, v, u, w);
+    }
+    else if (inAdjacency_List != nullptr)
+    {
+        pushNode(inAdjacency_List, inEdgeIndex, v, u, w);
+    }
+    countEdge(u, v, w);
+    notifyAdded(u, v, w);
+}
+
+// Updates the counters for a new edge (u,v) of weight w
+void Graph::countEdge(int u, int v, int w)
+{
+    if (edgeCount == 0 && !weightBoundsStale)
+    {
+        minWeight = w;
+        maxWeight = w;
+    }
+    else
+    {
+        if (w < minWeight)
+            minWeight = w;
+        if (w > maxWeight)
+            maxWeight = w;
+    }
+    edgeCount++;
     if (w < 0)
     {
-        isNegative = true;
+        negativeCount++;
     }
-    // Create a new node for the edge and add it to the adjacency list
-    Node *nodeU = new Node(v, w);
-    nodeU->next = adjacency_List[u];
-    adjacency_List[u] = nodeU;
-    //because the graph is undirected, we add the edge for to the other vertex too
-    Node *nodeV = new Node(u, w);
-    nodeV->next = adjacency_List[v];
-    adjacency_List[v] = nodeV;
-}
-// Function to remove an edge from the graph
+    degree[u]++;
+    if (directed)
+        inDegree[v]++;
+    else
+        degree[v]++;
+}
+
+// Updates the counters for a removed edge (u,v) of weight w.
+// Only if it held the min or max weight do the bounds need a rescan, done lazily.
+void Graph::uncountEdge(int u, int v, int w)
+{
+    edgeCount--;
+    if (w < 0)
+    {
+        negativeCount--;
+    }
+    degree[u]--;
+    if (directed)
+        inDegree[v]--;
+    else
+        degree[v]--;
+    if (w == minWeight || w == maxWeight)
+    {
+        weightBoundsStale = true;
+    }
+}
+
+// Rescans all edges for the min and max weight
+void Graph::recomputeWeightBounds() const
+{
+    bool first = true;
+    minWeight = 0;
+    maxWeight = 0;
+    for (int i = 0; i < n; i++)
+    {
+        Node *curr = adjacency_List[i];
+        while (curr != nullptr)
+        {
+            if (first || curr->weight < minWeight)
+                minWeight = curr->weight;
+            if (first || curr->weight > maxWeight)
+                maxWeight = curr->weight;
+            first = false;
+            curr = curr->next;
+        }
+    }
+    weightBoundsStale = false;
+}
+// Finds the node of v in the list of u, or nullptr
+Node *Graph::findNode(Node **lists, EdgeIndex *index, int u, int v)
+{
+    if (index != nullptr)
+    {
+        return index[u].find(v);
+    }
+    Node *curr = lists[u];
+    while (curr != nullptr && curr->vertex != v)
+    {
+        curr = curr->next;
+    }
+    return curr;
+}
+
+// Removes one node of v from the list of u.
+// With the index the node is found in O(1); since the list is singly linked,
+// the head's contents are moved into it and the head is unlinked instead.
+bool Graph::removeNode(Node **lists, EdgeIndex *index, int u, int v, int &weight)
+{
+    if (index != nullptr)
+    {
+        Node *target = index[u].find(v);
+        if (target == nullptr)
+        {
+            return false;
+        }
+        Node *head = lists[u];
+        weight = target->weight;
+        index[u].erase(v, target);
+        if (target != head)
+        {
+            index[u].replace(head->vertex, head, target);
+            target->vertex = head->vertex;
+            target->weight = head->weight;
+        }
+        lists[u] = head->next;
+        freeNode(head);
+        return true;
+    }
+    Node *currU = lists[u];
+    if (currU != nullptr && currU->vertex == v)
+    {
+        lists[u] = currU->next;
+        weight = currU->weight;
+        freeNode(currU);
+        return true;
+    }
+    while (currU != nullptr && currU->next != nullptr)
+    {
+        if (currU->next->vertex == v)
+        {
+            Node *temp = currU->next;
+            weight = temp->weight;
+            currU->next = currU->next->next;
+            freeNode(temp);
+            return true;
+        }
+        currU = currU->next;
+    }
+    return false;
+}
+
+// Function to remove an edge from the graph (the edge u->v if directed)
 void Graph::removeEdge(int u, int v)
 {
     // Check if the vertex indices are within bounds
@@ -45,60 +241,454 @@ void Graph::removeEdge(int u, int v)
     {
         throw std::out_of_range("removeEdge: Vertex index out of bounds");
     }
-    Node *currU = adjacency_List[u];
-    if (currU != nullptr && currU->vertex == v)
+    int weight = 0;
+    int otherWeight = 0;
+    if (removeNode(adjacency_List, edgeIndex, u, v, weight))
+    {
+        if (!directed)
+        {
+            removeNode(adjacency_List, edgeIndex, v, u, otherWeight);
+        }
+        else if (inAdjacency_List != nullptr)
+        {
+            removeNode(inAdjacency_List, inEdgeIndex, v, u, otherWeight);
+        }
+        uncountEdge(u, v, weight);
+        notifyRemoved(u, v, weight);
+    }
+}
+
+// Builds a hash index over every list of the given array
+EdgeIndex *Graph::indexLists(Node **lists) const
+{
+    EdgeIndex *index = new EdgeIndex[n];
+    for (int i = 0; i < n; i++)
+    {
+        Node *curr = lists[i];
+        while (curr != nullptr)
+        {
+            index[i].insert(curr->vertex, curr);
+            curr = curr->next;
+        }
+    }
+    return index;
+}
+
+// Builds a hash index over every adjacency list (and in-edge list).
+// From now on hasEdge, removeEdge and updateWeight find edges in O(1).
+void Graph::buildEdgeIndex()
+{
+    if (edgeIndex != nullptr)
+    {
+        return;
+    }
+    edgeIndex = indexLists(adjacency_List);
+    if (inAdjacency_List != nullptr)
+    {
+        inEdgeIndex = indexLists(inAdjacency_List);
+    }
+}
+
+// Returns true if buildEdgeIndex() was called
+bool Graph::hasEdgeIndex() const
+{
+    return edgeIndex != nullptr;
+}
+
+// Returns true if there is an edge between u and v (from u to v if directed)
+bool Graph::hasEdge(int u, int v) const
+{
+    if (u < 0 || u >= n || v < 0 || v >= n)
+    {
+        throw std::out_of_range("hasEdge: Vertex index out of bounds");
+    }
+    return findNode(adjacency_List, edgeIndex, u, v) != nullptr;
+}
+
+// Changes the weight of edge (u,v) in both of its lists.
+// Returns false if there is no such edge.
+bool Graph::updateWeight(int u, int v, int w)
+{
+    if (u < 0 || u >= n || v < 0 || v >= n)
+    {
+        throw std::out_of_range("updateWeight: Vertex index out of bounds");
+    }
+    Node *nodeU = findNode(adjacency_List, edgeIndex, u, v);
+    if (nodeU == nullptr)
     {
-        adjacency_List[u] = currU->next;
-        delete currU;
+        return false;
+    }
+    int oldWeight = nodeU->weight;
+    nodeU->weight = w;
+    Node *nodeV = nullptr;
+    if (directed)
+    {
+        if (inAdjacency_List != nullptr)
+        {
+            nodeV = findNode(inAdjacency_List, inEdgeIndex, v, u);
+        }
+    }
+    else if (u == v)
+    {
+        // A self loop keeps two nodes in the same list, update the other one
+        nodeV = adjacency_List[u];
+        while (nodeV != nullptr && (nodeV->vertex != u || nodeV == nodeU))
+        {
+            nodeV = nodeV->next;
+        }
     }
     else
     {
-        while (currU != nullptr && currU->next != nullptr)
+        nodeV = findNode(adjacency_List, edgeIndex, v, u);
+    }
+    if (nodeV != nullptr)
+    {
+        nodeV->weight = w;
+    }
+    reweighEdge(oldWeight, w);
+    notifyWeightChanged(u, v, oldWeight, w);
+    return true;
+}
+
+// Updates the counters for an edge whose weight changed from oldWeight to w
+void Graph::reweighEdge(int oldWeight, int w)
+{
+    negativeCount += (w < 0) - (oldWeight < 0);
+    if (w < minWeight)
+        minWeight = w;
+    if (w > maxWeight)
+        maxWeight = w;
+    if (oldWeight == minWeight || oldWeight == maxWeight)
+    {
+        weightBoundsStale = true;
+    }
+}
+
+// Checks every endpoint of a batch before anything is changed
+void Graph::checkBatch(const Edge *edges, int k, const char *who) const
+{
+    if (k < 0 || (k > 0 && edges == nullptr))
+    {
+        throw std::invalid_argument(std::string(who) + ": Invalid edge array");
+    }
+    for (int i = 0; i < k; i++)
+    {
+        if (edges[i].u < 0 || edges[i].u >= n || edges[i].v < 0 || edges[i].v >= n)
         {
-            if (currU->next->vertex == v)
+            throw std::out_of_range(std::string(who) + ": Vertex index out of bounds");
+        }
+    }
+}
+
+// The neighbor a request means in the list of x
+int Graph::neighborIn(const Edge &e, int x, ListSide side)
+{
+    if (side == OUT_LISTS)
+        return e.v;
+    if (side == IN_LISTS)
+        return e.u;
+    return e.u == x ? e.v : e.u;
+}
+
+// Groups the requests of a batch by the vertex whose list they change.
+// keys gets one entry (x << 32 | i) for every list x that request i changes, sorted,
+// so the requests for x are consecutive and in batch order. Returns how many there are.
+// BOTH_ENDS lists an edge (u,v) under both u and v (a self loop twice under u),
+// OUT_LISTS only under u and IN_LISTS only under v.
+// Sorting the k requests instead of counting over all vertices keeps a small
+// batch on a big graph at O(k log k), with nothing of size n allocated or scanned.
+int Graph::groupByVertex(const Edge *edges, int k, ListSide side, long long *keys) const
+{
+    int m = 0;
+    for (int i = 0; i < k; i++)
+    {
+        if (side != IN_LISTS)
+            keys[m++] = ((long long)edges[i].u << 32) | i;
+        if (side != OUT_LISTS)
+            keys[m++] = ((long long)edges[i].v << 32) | i;
+    }
+    std::sort(keys, keys + m);
+    return m;
+}
+
+// Removes the batch from one array of lists (see groupByVertex for side).
+// Each touched list is compacted in a single pass that stops as soon as all
+// of its removals are done. When count is set the counters are updated,
+// the removed edges are written to log (unless it is null) and their number is returned.
+int Graph::removeFromLists(Node **lists, EdgeIndex *index, const Edge *edges, int k, ListSide side, bool count, Edge *log)
+{
+    long long *keys = new long long[2 * k];
+    int m = groupByVertex(edges, k, side, keys);
+    int *ids = new int[2 * k];   // distinct neighbors to drop from the current list, sorted
+    int *left = new int[2 * k];  // how many nodes of each of them still go
+
+    int removed = 0;
+    for (int first = 0, last = 0; first < m; first = last)
+    {
+        int x = (int)(keys[first] >> 32);
+        while (last < m && (int)(keys[last] >> 32) == x)
+        {
+            last++;
+        }
+        int remaining = last - first;
+        for (int j = first; j < last; j++)
+        {
+            ids[j - first] = neighborIn(edges[(int)(keys[j] & 0xffffffff)], x, side);
+        }
+        std::sort(ids, ids + remaining);
+        int distinct = 0;
+        for (int j = 0; j < remaining; j++)
+        {
+            if (distinct > 0 && ids[distinct - 1] == ids[j])
+            {
+                left[distinct - 1]++;
+            }
+            else
+            {
+                ids[distinct] = ids[j];
+                left[distinct++] = 1;
+            }
+        }
+
+        int selfLoopNodes = 0;
+        Node **link = &lists[x];
+        while (*link != nullptr && remaining > 0)
+        {
+            Node *curr = *link;
+            int y = curr->vertex;
+            int *at = std::lower_bound(ids, ids + distinct, y);
+            if (at == ids + distinct || *at != y || left[at - ids] == 0)
+            {
+                link = &curr->next;
+                continue;
+            }
+            left[at - ids]--;
+            remaining--;
+            *link = curr->next;
+            if (index != nullptr)
             {
-                Node *temp = currU->next;
-                currU->next = currU->next->next;
-                delete (temp);
-                break;
+                index[x].erase(y, curr);
             }
-            currU = currU->next;
+            // An undirected edge is counted once: from its smaller end, a self loop every second node
+            if (count && (side != BOTH_ENDS || y > x || (y == x && ++selfLoopNodes % 2 == 0)))
+            {
+                uncountEdge(x, y, curr->weight);
+                if (log != nullptr)
+                {
+                    log[removed] = Edge(x, y, curr->weight);
+                }
+                removed++;
+            }
+            freeNode(curr);
         }
     }
-    Node *currV = adjacency_List[v];
-    if (currV != nullptr && currV->vertex == u)
+
+    delete[] left;
+    delete[] ids;
+    delete[] keys;
+    return removed;
+}
+
+// Removes a batch of edges (the weights in edges are ignored).
+// Returns how many edges were removed.
+int Graph::removeEdges(const Edge *edges, int k)
+{
+    checkBatch(edges, k, "removeEdges");
+    // Listeners hear about the batch only once every list is consistent again
+    Edge *log = listenerCount > 0 ? new Edge[k] : nullptr;
+    int removed;
+    if (!directed)
     {
-        adjacency_List[v] = currV->next;
-        delete currV;
+        removed = removeFromLists(adjacency_List, edgeIndex, edges, k, BOTH_ENDS, true, log);
     }
     else
     {
-        while (currV != nullptr && currV->next != nullptr)
+        removed = removeFromLists(adjacency_List, edgeIndex, edges, k, OUT_LISTS, true, log);
+        if (inAdjacency_List != nullptr)
         {
-            if (currV->next->vertex == u)
-            {
-                Node *temp = currV->next;
-                currV->next = currV->next->next;
-                delete (temp);
-                break;
-            }
-            currV = currV->next;
+            removeFromLists(inAdjacency_List, inEdgeIndex, edges, k, IN_LISTS, false, nullptr);
         }
     }
-    isNegative = false;
-    for (int i = 0; i < n; i++)
+    for (int i = 0; log != nullptr && i < removed; i++)
     {
-        Node *curr = adjacency_List[i];
-        while (curr != nullptr)
+        notifyRemoved(log[i].u, log[i].v, log[i].weight);
+    }
+    delete[] log;
+    return removed;
+}
+
+// Sets new weights in one array of lists (see groupByVertex for side).
+// If the same pair appears twice the later entry wins. Undirected self loops
+// are skipped here. When count is set the counters are updated, the changes
+// go to log/oldLog (unless null) and the number of updated edges is returned.
+int Graph::reweighLists(Node **lists, const Edge *edges, int k, ListSide side, bool count, Edge *log, int *oldLog)
+{
+    long long *keys = new long long[2 * k];
+    int m = groupByVertex(edges, k, side, keys);
+    long long *wanted = new long long[2 * k]; // (neighbor << 32 | request) of the current list
+    int *ids = new int[2 * k];                 // distinct neighbors of the current list, sorted
+    int *request = new int[2 * k];             // index in edges of the update for each of them, or -1
+
+    int updated = 0;
+    for (int first = 0, last = 0; first < m; first = last)
+    {
+        int x = (int)(keys[first] >> 32);
+        int g = 0;
+        for (; last < m && (int)(keys[last] >> 32) == x; last++)
         {
-            if (curr->weight < 0)
+            int i = (int)(keys[last] & 0xffffffff);
+            int y = neighborIn(edges[i], x, side);
+            if (side != BOTH_ENDS || y != x)
+            {
+                wanted[g++] = ((long long)y << 32) | i;
+            }
+        }
+        std::sort(wanted, wanted + g);
+        int remaining = 0;
+        for (int j = 0; j < g; j++)
+        {
+            int y = (int)(wanted[j] >> 32);
+            if (remaining > 0 && ids[remaining - 1] == y)
+            {
+                remaining--;         // same pair again: the later request replaces it
+            }
+            ids[remaining] = y;
+            request[remaining++] = (int)(wanted[j] & 0xffffffff);
+        }
+        int distinct = remaining;
+
+        Node *curr = lists[x];
+        while (curr != nullptr && remaining > 0)
+        {
+            int y = curr->vertex;
+            int *at = std::lower_bound(ids, ids + distinct, y);
+            if (at != ids + distinct && *at == y && request[at - ids] != -1)
             {
-                isNegative = true;
-                return;
+                int oldWeight = curr->weight;
+                curr->weight = edges[request[at - ids]].weight;
+                if (count && (side != BOTH_ENDS || y > x))
+                {
+                    reweighEdge(oldWeight, curr->weight);
+                    if (log != nullptr)
+                    {
+                        log[updated] = Edge(x, y, curr->weight);
+                        oldLog[updated] = oldWeight;
+                    }
+                    updated++;
+                }
+                request[at - ids] = -1;
+                remaining--;
             }
             curr = curr->next;
         }
     }
+
+    delete[] request;
+    delete[] ids;
+    delete[] wanted;
+    delete[] keys;
+    return updated;
+}
+
+// Sets the weight of a batch of edges, one (u,v) edge per entry.
+// Each touched list is walked once. Returns how many edges were updated.
+int Graph::updateWeights(const Edge *edges, int k)
+{
+    checkBatch(edges, k, "updateWeights");
+    // Listeners hear about the batch only once both copies of every edge agree
+    Edge *log = listenerCount > 0 ? new Edge[k] : nullptr;
+    int *oldLog = listenerCount > 0 ? new int[k] : nullptr;
+    int updated;
+    if (directed)
+    {
+        updated = reweighLists(adjacency_List, edges, k, OUT_LISTS, true, log, oldLog);
+        if (inAdjacency_List != nullptr)
+        {
+            reweighLists(inAdjacency_List, edges, k, IN_LISTS, false, nullptr, nullptr);
+        }
+    }
+    else
+    {
+        updated = reweighLists(adjacency_List, edges, k, BOTH_ENDS, true, log, oldLog);
+    }
+    for (int i = 0; log != nullptr && i < updated; i++)
+    {
+        notifyWeightChanged(log[i].u, log[i].v, oldLog[i], log[i].weight);
+    }
+    delete[] log;
+    delete[] oldLog;
+    if (directed)
+    {
+        return updated;
+    }
+    for (int i = 0; i < k; i++)
+    {
+        if (edges[i].u == edges[i].v && updateWeight(edges[i].u, edges[i].u, edges[i].weight))
+        {
+            updated++;
+        }
+    }
+    return updated;
+}
+// Attaches a listener that is told about every later edge change
+void Graph::addListener(GraphListener *listener)
+{
+    if (listener == nullptr)
+    {
+        throw std::invalid_argument("addListener: listener is null");
+    }
+    GraphListener **grown = new GraphListener *[listenerCount + 1];
+    for (int i = 0; i < listenerCount; i++)
+    {
+        grown[i] = listeners[i];
+    }
+    grown[listenerCount++] = listener;
+    delete[] listeners;
+    listeners = grown;
+}
+// Detaches a listener, nothing happens if it was not attached
+void Graph::removeListener(GraphListener *listener)
+{
+    for (int i = 0; i < listenerCount; i++)
+    {
+        if (listeners[i] == listener)
+        {
+            listeners[i] = listeners[--listenerCount];
+            return;
+        }
+    }
+}
+// Tells every listener about a new edge
+void Graph::notifyAdded(int u, int v, int w)
+{
+    for (int i = 0; i < listenerCount; i++)
+    {
+        listeners[i]->onEdgeAdded(u, v, w);
+    }
+}
+// Tells every listener about a removed edge
+void Graph::notifyRemoved(int u, int v, int w)
+{
+    for (int i = 0; i < listenerCount; i++)
+    {
+        listeners[i]->onEdgeRemoved(u, v, w);
+    }
+}
+// Tells every listener about a changed weight
+void Graph::notifyWeightChanged(int u, int v, int oldWeight, int w)
+{
+    for (int i = 0; i < listenerCount; i++)
+    {
+        listeners[i]->onWeightChanged(u, v, oldWeight, w);
+    }
+}
+// Tells every listener that the whole graph was replaced by a move
+void Graph::notifyReplaced()
+{
+    for (int i = 0; i < listenerCount; i++)
+    {
+        listeners[i]->onGraphReplaced();
+    }
 }
 // Function to print the graph
 void Graph::print_graph()
@@ -115,20 +705,213 @@ void Graph::print_graph()
         std::cout << std::endl;
     }
 }
-// Destructor to free memory
-Graph::~Graph()
+// Frees a node, unless it lives in the block allocated by clone()
+void Graph::freeNode(Node *node)
+{
+    std::less<const Node *> before;
+    if (nodePool == nullptr || before(node, nodePool) || !before(node, nodePool + poolSize))
+    {
+        delete node;
+    }
+}
+// Frees every node of an array of lists and the array itself
+void Graph::freeLists(Node **lists)
 {
+    if (lists == nullptr)
+    {
+        return;
+    }
     for (int i = 0; i < n; i++)
     {
-        Node *current = adjacency_List[i];
+        Node *current = lists[i];
         while (current != nullptr)
         {
             Node *temp = current;
             current = current->next;
-            delete temp;
+            freeNode(temp);
+        }
+    }
+    delete[] lists;
+}
+// Frees everything the graph owns
+void Graph::release()
+{
+    freeLists(adjacency_List);
+    freeLists(inAdjacency_List);
+    delete[] nodePool;
+    delete[] edgeIndex;
+    delete[] inEdgeIndex;
+    delete[] degree;
+    delete[] inDegree;
+}
+// Takes everything other owns and leaves it as an empty graph with no vertices.
+// Listeners are not moved: each one holds a reference to the graph it was attached
+// to, so they stay with their own graph (and detach from it when destroyed).
+void Graph::takeFrom(Graph &other)
+{
+    n = other.n;
+    adjacency_List = other.adjacency_List;
+    directed = other.directed;
+    inAdjacency_List = other.inAdjacency_List;
+    nodePool = other.nodePool;
+    poolSize = other.poolSize;
+    edgeIndex = other.edgeIndex;
+    inEdgeIndex = other.inEdgeIndex;
+    edgeCount = other.edgeCount;
+    negativeCount = other.negativeCount;
+    degree = other.degree;
+    inDegree = other.inDegree;
+    minWeight = other.minWeight;
+    maxWeight = other.maxWeight;
+    weightBoundsStale = other.weightBoundsStale;
+
+    other.n = 0;
+    other.adjacency_List = nullptr;
+    other.inAdjacency_List = nullptr;
+    other.nodePool = nullptr;
+    other.poolSize = 0;
+    other.edgeIndex = nullptr;
+    other.inEdgeIndex = nullptr;
+    other.edgeCount = 0;
+    other.negativeCount = 0;
+    other.degree = nullptr;
+    other.inDegree = nullptr;
+}
+// Move constructor, no node is copied
+Graph::Graph(Graph &&other) noexcept
+{
+    takeFrom(other);
+}
+// Move assignment, frees what this graph had before. Its listeners stay and
+// are told that their graph changed as a whole.
+Graph &Graph::operator=(Graph &&other) noexcept
+{
+    if (this != &other)
+    {
+        release();
+        takeFrom(other);
+        notifyReplaced();
+    }
+    return *this;
+}
+// Copies one array of lists into consecutive nodes of the pool, keeping the order.
+// List x of the copy is list oldIds[x] of the original with every id renamed by newIds
+// (both nullptr for a plain copy), so the nodes of one vertex end up next to each other.
+static Node **copyLists(Node **lists, int n, const int *newIds, const int *oldIds, Node *pool, int &used)
+{
+    Node **copy = new Node *[n];
+    for (int x = 0; x < n; x++)
+    {
+        Node **link = &copy[x];
+        for (Node *curr = lists[oldIds == nullptr ? x : oldIds[x]]; curr != nullptr; curr = curr->next)
+        {
+            Node *node = &pool[used++];
+            node->vertex = newIds == nullptr ? curr->vertex : newIds[curr->vertex];
+            node->weight = curr->weight;
+            *link = node;
+            link = &node->next;
+        }
+        *link = nullptr;
+    }
+    return copy;
+}
+// Deep copy with vertex x renamed to newIds[x] (oldIds is the inverse),
+// or a plain copy when both are nullptr. All nodes come from one allocation.
+Graph Graph::copyRenamed(const int *newIds, const int *oldIds) const
+{
+    Graph copy(0);
+    delete[] copy.adjacency_List;
+    delete[] copy.degree;
+    copy.n = n;
+    copy.directed = directed;
+
+    int total = 0;
+    for (int i = 0; i < n; i++)
+    {
+        total += degree[i];
+    }
+    if (directed && inAdjacency_List != nullptr)
+    {
+        total += edgeCount;
+    }
+    copy.nodePool = new Node[total];
+    copy.poolSize = total;
+    int used = 0;
+    copy.adjacency_List = copyLists(adjacency_List, n, newIds, oldIds, copy.nodePool, used);
+    if (inAdjacency_List != nullptr)
+    {
+        copy.inAdjacency_List = copyLists(inAdjacency_List, n, newIds, oldIds, copy.nodePool, used);
+    }
+
+    copy.degree = new int[n];
+    for (int x = 0; x < n; x++)
+    {
+        copy.degree[x] = degree[oldIds == nullptr ? x : oldIds[x]];
+    }
+    if (inDegree != nullptr)
+    {
+        copy.inDegree = new int[n];
+        for (int x = 0; x < n; x++)
+        {
+            copy.inDegree[x] = inDegree[oldIds == nullptr ? x : oldIds[x]];
+        }
+    }
+    copy.edgeCount = edgeCount;
+    copy.negativeCount = negativeCount;
+    copy.minWeight = minWeight;
+    copy.maxWeight = maxWeight;
+    copy.weightBoundsStale = weightBoundsStale;
+    if (edgeIndex != nullptr)
+    {
+        copy.buildEdgeIndex();
+    }
+    return copy;
+}
+// Deep copy. All nodes come from one allocation instead of one new per node.
+Graph Graph::clone() const
+{
+    return copyRenamed(nullptr, nullptr);
+}
+// Copy in which vertex v is called newIds[v]; newIds must be a permutation of 0..n-1
+Graph Graph::renumbered(const int *newIds) const
+{
+    int *oldIds = new int[n];
+    for (int i = 0; i < n; i++)
+    {
+        oldIds[i] = -1;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        if (newIds[v] < 0 || newIds[v] >= n || oldIds[newIds[v]] != -1)
+        {
+            delete[] oldIds;
+            throw std::invalid_argument("renumbered: newIds is not a permutation");
         }
+        oldIds[newIds[v]] = v;
     }
-    delete[] adjacency_List;
+    Graph copy = copyRenamed(newIds, oldIds);
+    delete[] oldIds;
+    return copy;
+}
+// Borrowed view of the adjacency lists, valid while this graph is alive and unchanged
+AdjacencyView Graph::view() const
+{
+    return AdjacencyView{n, adjacency_List};
+}
+// Borrowed view of the in-edge lists (the adjacency lists if undirected)
+AdjacencyView Graph::inEdgeView() const
+{
+    if (directed && inAdjacency_List == nullptr)
+    {
+        throw std::logic_error("inEdgeView: the graph does not track in-edges");
+    }
+    return AdjacencyView{n, directed ? inAdjacency_List : adjacency_List};
+}
+// Destructor to free memory
+Graph::~Graph()
+{
+    release();
+    delete[] listeners;
 }
 //helper function to get the number of vertices
 int Graph::getNumVertices() const
@@ -140,8 +923,210 @@ Node **Graph::getAdjList() const
 {
     return adjacency_List;
 }
-//getter for isNegative, to check if the graph has negative edges(for dijkstra)
+//getter for the lists of incoming edges, nullptr unless tracked
+Node **Graph::getInAdjList() const
+{
+    return inAdjacency_List;
+}
+//true if edges only go from u to v
+bool Graph::isDirected() const
+{
+    return directed;
+}
+//true if the lists of incoming edges are kept
+bool Graph::hasInEdges() const
+{
+    return inAdjacency_List != nullptr;
+}
+//checks if the graph has negative edges(for dijkstra), O(1) thanks to the counter
 bool Graph::getIsNegative() const
 {
-    return isNegative;
+    return negativeCount > 0;
+}
+//getter for the number of edges with a negative weight, kept up to date like the edge count
+int Graph::getNegativeCount() const
+{
+    return negativeCount;
+}
+//getter for the number of edges
+int Graph::getEdgeCount() const
+{
+    return edgeCount;
+}
+//getter for the degree of u (out-degree if directed)
+int Graph::getDegree(int u) const
+{
+    if (u < 0 || u >= n)
+    {
+        throw std::out_of_range("getDegree: Vertex index out of bounds");
+    }
+    return degree[u];
+}
+//getter for the number of edges coming into u (same as getDegree if undirected)
+int Graph::getInDegree(int u) const
+{
+    if (u < 0 || u >= n)
+    {
+        throw std::out_of_range("getInDegree: Vertex index out of bounds");
+    }
+    return directed ? inDegree[u] : degree[u];
+}
+//getter for the smallest edge weight
+int Graph::getMinWeight() const
+{
+    if (weightBoundsStale)
+    {
+        recomputeWeightBounds();
+    }
+    return minWeight;
+}
+//getter for the largest edge weight
+int Graph::getMaxWeight() const
+{
+    if (weightBoundsStale)
+    {
+        recomputeWeightBounds();
+    }
+    return maxWeight;
+}
+
+// ===== EdgeIndex Implementation =====
+
+static const int EMPTY = -1;
+static const int DELETED = -2;
+
+// Mixes the bits of a vertex id so that nearby ids spread over the table
+static unsigned int hashVertex(int key)
+{
+    unsigned int h = (unsigned int)key;
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Empty index, the table is allocated on the first insert
+EdgeIndex::EdgeIndex()
+{
+    keys = nullptr;
+    nodes = nullptr;
+    capacity = 0;
+    count = 0;
+    used = 0;
+}
+
+// Destructor, the nodes themselves belong to the graph
+EdgeIndex::~EdgeIndex()
+{
+    delete[] keys;
+    delete[] nodes;
+}
+
+// Returns the slot holding (key, node), or -1 if there is none.
+// A null node matches any entry with that key.
+int EdgeIndex::slotOf(int key, const Node *node) const
+{
+    if (capacity == 0)
+    {
+        return -1;
+    }
+    int mask = capacity - 1;
+    for (int i = hashVertex(key) & mask; keys[i] != EMPTY; i = (i + 1) & mask)
+    {
+        if (keys[i] == key && (node == nullptr || nodes[i] == node))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Moves all live entries into a new table, dropping the deleted markers
+void EdgeIndex::rehash(int newCapacity)
+{
+    int *oldKeys = keys;
+    Node **oldNodes = nodes;
+    int oldCapacity = capacity;
+
+    keys = new int[newCapacity];
+    nodes = new Node *[newCapacity];
+    capacity = newCapacity;
+    for (int i = 0; i < capacity; i++)
+    {
+        keys[i] = EMPTY;
+    }
+    int mask = capacity - 1;
+    for (int i = 0; i < oldCapacity; i++)
+    {
+        if (oldKeys[i] >= 0)
+        {
+            int j = hashVertex(oldKeys[i]) & mask;
+            while (keys[j] != EMPTY)
+            {
+                j = (j + 1) & mask;
+            }
+            keys[j] = oldKeys[i];
+            nodes[j] = oldNodes[i];
+        }
+    }
+    used = count;
+    delete[] oldKeys;
+    delete[] oldNodes;
+}
+
+// Adds an entry, keeping the table at most half full
+void EdgeIndex::insert(int key, Node *node)
+{
+    if ((used + 1) * 2 > capacity)
+    {
+        int newCapacity = 8;
+        while (newCapacity < (count + 1) * 4)
+        {
+            newCapacity *= 2;
+        }
+        rehash(newCapacity);
+    }
+    int mask = capacity - 1;
+    int i = hashVertex(key) & mask;
+    while (keys[i] >= 0)
+    {
+        i = (i + 1) & mask;
+    }
+    if (keys[i] == EMPTY)
+    {
+        used++;
+    }
+    keys[i] = key;
+    nodes[i] = node;
+    count++;
+}
+
+// Returns a node holding key, or nullptr
+Node *EdgeIndex::find(int key) const
+{
+    int i = slotOf(key, nullptr);
+    return i == -1 ? nullptr : nodes[i];
+}
+
+// Removes the entry (key, node) if present
+void EdgeIndex::erase(int key, const Node *node)
+{
+    int i = slotOf(key, node);
+    if (i != -1)
+    {
+        keys[i] = DELETED;
+        count--;
+    }
+}
+
+// Points the entry (key, oldNode) at newNode instead
+void EdgeIndex::replace(int key, const Node *oldNode, Node *newNode)
+{
+    int i = slotOf(key, oldNode);
+    if (i != -1)
+    {
+        nodes[i] = newNode;
+    }
 }
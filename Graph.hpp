@@ -9,24 +9,165 @@ namespace graph{
     int vertex;
     int weight;
     Node* next;
+    Node(): vertex(0), weight(0), next(nullptr){} // for bulk allocation
     Node(int v, int w): vertex(v), weight(w), next(nullptr){} // constructor
     };
 
+    // Open-addressing hash table (linear probing) from neighbor id to the Node
+    // holding it in one adjacency list. Parallel edges give several entries
+    // with the same key; find returns any of them.
+    class EdgeIndex{
+        private:
+            int* keys;      // EMPTY, DELETED or a neighbor id
+            Node** nodes;
+            int capacity;   // always a power of two (or 0 before the first insert)
+            int count;      // live entries
+            int used;       // live + deleted entries
+            int slotOf(int key, const Node* node) const;
+            void rehash(int newCapacity);
+        public:
+            EdgeIndex();
+            ~EdgeIndex();
+            void insert(int key, Node* node);
+            Node* find(int key) const;
+            void erase(int key, const Node* node);
+            void replace(int key, const Node* oldNode, Node* newNode);
+    };
+
+    // Borrowed, read-only view over an array of adjacency lists owned by someone else.
+    // It never frees anything and is only valid while the owner is alive.
+    struct AdjacencyView{
+        int n;
+        Node** lists;
+        int getNumVertices() const { return n; }
+        // Calls f(v, w) for every node in the list of u until f returns false
+        template <class F> bool forEachNeighbor(int u, F f) const
+        {
+            for (Node* curr = lists[u]; curr != nullptr; curr = curr->next)
+            {
+                if (!f(curr->vertex, curr->weight)) return false;
+            }
+            return true;
+        }
+        // Calls f(v) for every node in the list of u until f returns false
+        template <class F> bool forEachAdjacent(int u, F f) const
+        {
+            for (Node* curr = lists[u]; curr != nullptr; curr = curr->next)
+            {
+                if (!f(curr->vertex)) return false;
+            }
+            return true;
+        }
+    };
+
+    // Gets told about every edge change of a Graph it is attached to with addListener.
+    // Each edge is reported once, after the change, on the thread that made it.
+    // Batch calls report their edges only once every list (both ends, in-edges
+    // too) is updated, so a listener may read the graph from inside a callback.
+    // Listeners stay with the graph they were attached to: a move or a clone
+    // starts with none, and a graph moved into keeps its own and calls their
+    // onGraphReplaced, since every edge and maybe the vertex count changed.
+    // That call comes from a noexcept move, so it must not throw.
+    class GraphListener{
+        public:
+            virtual ~GraphListener() {}
+            virtual void onEdgeAdded(int, int, int) {} // (u, v, w)
+            virtual void onEdgeRemoved(int, int, int) {} // (u, v, weight it had)
+            virtual void onWeightChanged(int, int, int, int) {} // (u, v, old weight, new weight)
+            virtual void onGraphReplaced() {} // the graph was moved into
+    };
+
     class Graph{
         private: 
             int n; //number of vertices
             Node**  adjacency_List; 
-            bool isNegative = false; //boolean variable to check if the graph has negative weights
+            bool directed = false; // edges only go from u to v
+            Node** inAdjacency_List = nullptr; // directed only: edges coming into each vertex, if tracked
+            EdgeIndex* edgeIndex = nullptr; // one hash index per vertex, only after buildEdgeIndex()
+            EdgeIndex* inEdgeIndex = nullptr; // same for the in-edge lists
+            Node* nodePool = nullptr; // nodes allocated in one block by clone(), freed as a whole
+            int poolSize = 0;
+            // Counters kept up to date by every edge change, so queries never rescan the graph
+            int edgeCount = 0;
+            int negativeCount = 0; // number of edges with a negative weight
+            int* degree; // out-degree if directed
+            int* inDegree = nullptr; // directed only
+            mutable int minWeight = 0;
+            mutable int maxWeight = 0;
+            mutable bool weightBoundsStale = false; // an edge holding the min or max was removed
+            GraphListener** listeners = nullptr; // not owned
+            int listenerCount = 0;
+            // Which lists of a batch request are touched: both ends (undirected),
+            // the out list of u or the in list of v (directed)
+            enum ListSide { BOTH_ENDS, OUT_LISTS, IN_LISTS };
+            static int neighborIn(const Edge& e, int x, ListSide side);
+            static Node* pushNode(Node** lists, EdgeIndex* index, int u, int v, int w);
+            static Node* findNode(Node** lists, EdgeIndex* index, int u, int v);
+            bool removeNode(Node** lists, EdgeIndex* index, int u, int v, int& weight);
+            void freeNode(Node* node);
+            void freeLists(Node** lists);
+            void release();
+            void takeFrom(Graph& other);
+            Graph copyRenamed(const int* newIds, const int* oldIds) const;
+            EdgeIndex* indexLists(Node** lists) const;
+            void countEdge(int u, int v, int w);
+            void uncountEdge(int u, int v, int w);
+            void recomputeWeightBounds() const;
+            void reweighEdge(int oldWeight, int w);
+            void notifyAdded(int u, int v, int w);
+            void notifyRemoved(int u, int v, int w);
+            void notifyWeightChanged(int u, int v, int oldWeight, int w);
+            void notifyReplaced();
+            void checkBatch(const Edge* edges, int k, const char* who) const;
+            int groupByVertex(const Edge* edges, int k, ListSide side, long long* keys) const;
+            int removeFromLists(Node** lists, EdgeIndex* index, const Edge* edges, int k, ListSide side, bool count, Edge* log);
+            int reweighLists(Node** lists, const Edge* edges, int k, ListSide side, bool count, Edge* log, int* oldLog);
         public:
             Graph(int n); //addding to adjacency list the vertices
-            Graph(int n, Node** adj);// constructor to initialize the graph with an adjacency list
+            Graph(int n, bool directed, bool trackInEdges = false); // directed graph, optionally with in-edge lists
+            Graph(int n, Node** adj);// takes ownership of adj and all its nodes
             ~Graph(); // destructor to free memory
+            Graph(const Graph&) = delete; // copies must be explicit, use clone()
+            Graph& operator=(const Graph&) = delete;
+            Graph(Graph&& other) noexcept; // moves leave other with no vertices
+            Graph& operator=(Graph&& other) noexcept;
+            Graph clone() const; // deep copy, nodes allocated in one block
+            Graph renumbered(const int* newIds) const; // deep copy where vertex v becomes newIds[v]
+            AdjacencyView view() const; // borrowed view of the adjacency lists
+            AdjacencyView inEdgeView() const; // borrowed view of the in-edge lists
             void addEdge(int u, int v, int w); // function to add an edge
             void removeEdge(int u, int v); // function to remove an edge
+            void buildEdgeIndex(); // index every adjacency list, makes edge lookups O(1)
+            bool hasEdgeIndex() const;
+            bool hasEdge(int u, int v) const; // is there an edge between u and v
+            bool updateWeight(int u, int v, int w); // change the weight of edge (u,v), false if missing
+            int removeEdges(const Edge* edges, int k); // remove k edges at once, returns how many existed
+            int updateWeights(const Edge* edges, int k); // set the weight of k edges at once, returns how many existed
+            void addListener(GraphListener* listener); // listener must stay alive until removed
+            void removeListener(GraphListener* listener);
             void print_graph(); //print the graph
             int getNumVertices() const; // Getter for number of vertices
-            Node** getAdjList() const; //getter for adjacency list
-            bool getIsNegative() const; //getter for isNegative
+            Node** getAdjList() const; //getter for adjacency list, still owned by the graph
+            Node** getInAdjList() const; //getter for in-edge lists (nullptr unless tracked), still owned by the graph
+            bool isDirected() const;
+            bool hasInEdges() const;
+            bool getIsNegative() const; //true if any edge weight is negative
+            int getNegativeCount() const; // number of edges with a negative weight
+            int getEdgeCount() const; // number of edges
+            int getDegree(int u) const; // number of neighbors of u (out-degree if directed)
+            int getInDegree(int u) const; // number of edges into u
+            int getMinWeight() const; // smallest edge weight (0 if there are no edges)
+            int getMaxWeight() const; // largest edge weight (0 if there are no edges)
+            // Calls f(v, w) for every edge (u, v, w) until f returns false
+            template <class F> bool forEachNeighbor(int u, F f) const
+            {
+                return AdjacencyView{n, adjacency_List}.forEachNeighbor(u, f);
+            }
+            // Calls f(v) for every edge (u, v) until f returns false, for searches that ignore weights
+            template <class F> bool forEachAdjacent(int u, F f) const
+            {
+                return AdjacencyView{n, adjacency_List}.forEachAdjacent(u, f);
+            }
     };
 }
 #endif
@@ -0,0 +1,161 @@
+#include "IncrementalConnectivity.hpp"
+#include <stdexcept>
+using namespace graph;
+
+// Starts from the current edges of g and listens to it from now on
+IncrementalConnectivity::IncrementalConnectivity(Graph &g)
+{
+    this->g = &g;
+    uf = build(g);
+    stale = false;
+    rebuilding = false;
+    removedDuringRebuild = false;
+    pending = nullptr;
+    pendingCount = 0;
+    pendingCapacity = 0;
+    g.addListener(this);
+}
+
+// Waits for a running rebuild and detaches from the graph
+IncrementalConnectivity::~IncrementalConnectivity()
+{
+    waitForRebuild();
+    g->removeListener(this);
+    delete uf;
+    delete[] pending;
+}
+
+// Union-find holding the components of g
+UnionFind *IncrementalConnectivity::build(const Graph &g)
+{
+    int n = g.getNumVertices();
+    UnionFind *fresh = new UnionFind(n);
+    for (int u = 0; u < n; u++)
+    {
+        g.forEachAdjacent(u, [&](int v) {
+            fresh->unite(u, v);
+            return true;
+        });
+    }
+    return fresh;
+}
+
+// Replays the edges that arrived during a rebuild and swaps in the new union-find
+void IncrementalConnectivity::finishRebuild(UnionFind *fresh)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    for (int i = 0; i < pendingCount; i++)
+    {
+        fresh->unite(pending[i].u, pending[i].v);
+    }
+    pendingCount = 0;
+    delete uf;
+    uf = fresh;
+    stale = removedDuringRebuild;
+    rebuilding = false;
+}
+
+// True if u and v are in the same component
+bool IncrementalConnectivity::connected(int u, int v) const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return uf->connected(u, v);
+}
+
+// Number of components
+int IncrementalConnectivity::componentCount() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return uf->componentCount();
+}
+
+// Number of vertices in the component of u
+int IncrementalConnectivity::componentSize(int u) const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return uf->componentSize(u);
+}
+
+// True if an edge was removed after the answers were last rebuilt
+bool IncrementalConnectivity::isStale() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return stale;
+}
+
+// Synchronous rebuild from the graph
+void IncrementalConnectivity::rebuild()
+{
+    waitForRebuild();
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        removedDuringRebuild = false;
+    }
+    finishRebuild(build(*g));
+}
+
+// Background rebuild from a copy of the graph; waits for an earlier one first
+void IncrementalConnectivity::rebuildAsync()
+{
+    waitForRebuild();
+    Graph *copy = new Graph(g->clone());
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        rebuilding = true;
+        removedDuringRebuild = false;
+    }
+    rebuilder = std::thread([this, copy]() {
+        UnionFind *fresh = build(*copy);
+        delete copy;
+        finishRebuild(fresh);
+    });
+}
+
+// Joins the background rebuild, if there is one
+void IncrementalConnectivity::waitForRebuild()
+{
+    if (rebuilder.joinable())
+    {
+        rebuilder.join();
+    }
+}
+
+// One more edge: join the two components, and remember it for a running rebuild
+void IncrementalConnectivity::onEdgeAdded(int u, int v, int)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    uf->unite(u, v);
+    if (!rebuilding)
+    {
+        return;
+    }
+    if (pendingCount == pendingCapacity)
+    {
+        pendingCapacity = pendingCapacity == 0 ? 16 : pendingCapacity * 2;
+        Edge *grown = new Edge[pendingCapacity];
+        for (int i = 0; i < pendingCount; i++)
+        {
+            grown[i] = pending[i];
+        }
+        delete[] pending;
+        pending = grown;
+    }
+    pending[pendingCount++] = Edge(u, v, 0);
+}
+
+// A removed edge may split a component; that is only found by a rebuild
+void IncrementalConnectivity::onEdgeRemoved(int, int, int)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    stale = true;
+    if (rebuilding)
+    {
+        removedDuringRebuild = true;
+    }
+}
+
+// The graph was moved into: nothing of the old union-find is valid, not even its size
+void IncrementalConnectivity::onGraphReplaced()
+{
+    rebuild();
+}
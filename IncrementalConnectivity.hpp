@@ -0,0 +1,52 @@
+#ifndef _INCREMENTAL_CONNECTIVITY_HPP_
+#define _INCREMENTAL_CONNECTIVITY_HPP_
+#include "Graph.hpp"
+#include "DataStructures.hpp"
+#include <mutex>
+#include <thread>
+
+namespace graph{
+
+    // Answers "are u and v connected?" and "how many components?" for a graph
+    // that keeps growing, in near O(1) per query. It listens to the graph:
+    // every added edge is one union-find unite. A removed edge cannot be undone
+    // in a union-find, so it only marks the answers stale (they may then claim
+    // too much connectivity) until rebuild() or rebuildAsync() recomputes them.
+    // A graph replaced by a move is rebuilt from at once.
+    // Queries may come from any thread; the graph itself is changed by one thread.
+    class IncrementalConnectivity : public GraphListener{
+        private:
+            Graph* g;
+            UnionFind* uf;
+            mutable std::mutex lock; // guards everything below, and uf (find compresses paths)
+            bool stale;
+            bool rebuilding;
+            bool removedDuringRebuild;
+            Edge* pending; // edges added while a background rebuild runs
+            int pendingCount;
+            int pendingCapacity;
+            std::thread rebuilder;
+            static UnionFind* build(const Graph& g);
+            void finishRebuild(UnionFind* fresh);
+        public:
+            IncrementalConnectivity(Graph& g); // attaches itself to g, which must outlive it
+            ~IncrementalConnectivity();
+            IncrementalConnectivity(const IncrementalConnectivity&) = delete;
+            IncrementalConnectivity& operator=(const IncrementalConnectivity&) = delete;
+            bool connected(int u, int v) const;
+            int componentCount() const;
+            int componentSize(int u) const; // number of vertices in the component of u
+            bool isStale() const; // an edge was removed since the last rebuild
+            // Recomputes everything from the graph, on the calling thread
+            void rebuild();
+            // Copies the graph (on the calling thread, which must be the one changing it)
+            // and recomputes from the copy on a background thread. Edges added meanwhile
+            // are replayed before the new answers replace the old ones.
+            void rebuildAsync();
+            void waitForRebuild(); // blocks until a running background rebuild is done
+            void onEdgeAdded(int u, int v, int w) override;
+            void onEdgeRemoved(int u, int v, int w) override;
+            void onGraphReplaced() override;
+    };
+}
+#endif
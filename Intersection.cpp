@@ -0,0 +1,154 @@
+#include "Intersection.hpp"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+using namespace graph;
+
+// Scalar merge of a[i..] and b[j..], writing matches to out unless it is null
+int Intersection::mergeTail(const int *a, int na, int i, const int *b, int nb, int j, int *out)
+{
+    int found = 0;
+    while (i < na && j < nb)
+    {
+        if (a[i] < b[j])
+        {
+            i++;
+        }
+        else if (b[j] < a[i])
+        {
+            j++;
+        }
+        else
+        {
+            if (out != nullptr)
+            {
+                out[found] = a[i];
+            }
+            found++;
+            i++;
+            j++;
+        }
+    }
+    return found;
+}
+
+#if defined(__SSE2__)
+// Bit k is set if a[k] equals one of the 4 values of vb
+static inline int matchBlock(__m128i va, __m128i vb)
+{
+    __m128i hits = _mm_cmpeq_epi32(va, vb);
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    hits = _mm_or_si128(hits, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+    return _mm_movemask_ps(_mm_castsi128_ps(hits));
+}
+#endif
+
+// Counts common values. Blocks of 4 from each side are compared all against all,
+// then the block with the smaller last value moves on (both if they are equal).
+int Intersection::count(const int *a, int na, const int *b, int nb)
+{
+    int i = 0;
+    int j = 0;
+    int found = 0;
+#if defined(__SSE2__)
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        found += __builtin_popcount(matchBlock(va, vb));
+        int lastA = a[i + 3];
+        int lastB = b[j + 3];
+        if (lastA <= lastB)
+        {
+            i += 4;
+        }
+        if (lastB <= lastA)
+        {
+            j += 4;
+        }
+    }
+#endif
+    return found + mergeTail(a, na, i, b, nb, j, nullptr);
+}
+
+// Same walk as count, but the matched values of a are written out in order
+int Intersection::intersect(const int *a, int na, const int *b, int nb, int *out)
+{
+    int i = 0;
+    int j = 0;
+    int found = 0;
+#if defined(__SSE2__)
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+        int mask = matchBlock(va, vb);
+        for (int k = 0; mask != 0; k++, mask >>= 1)
+        {
+            if (mask & 1)
+            {
+                out[found++] = a[i + k];
+            }
+        }
+        int lastA = a[i + 3];
+        int lastB = b[j + 3];
+        if (lastA <= lastB)
+        {
+            i += 4;
+        }
+        if (lastB <= lastA)
+        {
+            j += 4;
+        }
+    }
+#endif
+    return found + mergeTail(a, na, i, b, nb, j, out + found);
+}
+
+// Plain merge that skips over repeats on both sides
+int Intersection::countDistinct(const int *a, int na, const int *b, int nb)
+{
+    int i = 0;
+    int j = 0;
+    int found = 0;
+    while (i < na && j < nb)
+    {
+        if (a[i] < b[j])
+        {
+            i++;
+        }
+        else if (b[j] < a[i])
+        {
+            j++;
+        }
+        else
+        {
+            int value = a[i];
+            found++;
+            while (i < na && a[i] == value)
+            {
+                i++;
+            }
+            while (j < nb && b[j] == value)
+            {
+                j++;
+            }
+        }
+    }
+    return found;
+}
+
+// Counts the positions where the value changes
+int Intersection::distinct(const int *a, int na)
+{
+    int values = 0;
+    for (int i = 0; i < na; i++)
+    {
+        if (i == 0 || a[i] != a[i - 1])
+        {
+            values++;
+        }
+    }
+    return values;
+}
@@ -0,0 +1,24 @@
+#ifndef _INTERSECTION_HPP_
+#define _INTERSECTION_HPP_
+
+namespace graph{
+
+    // Kernels on sorted int arrays, the building block of common-neighbor,
+    // Jaccard and triangle queries. count and intersect expect both inputs
+    // strictly increasing (sets); on x86 they compare 4 x 4 values at a time
+    // with SSE2, elsewhere they fall back to a plain merge.
+    class Intersection{
+        public:
+            // Size of a ∩ b
+            static int count(const int* a, int na, const int* b, int nb);
+            // Writes a ∩ b to out (room for min(na, nb) values), returns how many
+            static int intersect(const int* a, int na, const int* b, int nb, int* out);
+            // Size of a ∩ b when values may repeat (only non-decreasing); each value counts once
+            static int countDistinct(const int* a, int na, const int* b, int nb);
+            // Number of different values in a non-decreasing array
+            static int distinct(const int* a, int na);
+        private:
+            static int mergeTail(const int* a, int na, int i, const int* b, int nb, int j, int* out);
+    };
+}
+#endif
@@ -0,0 +1,229 @@
+#include "Reordering.hpp"
+#include <algorithm>
+#include <stdexcept>
+using namespace graph;
+
+// ===== Permutation Implementation =====
+
+// Identity permutation on n vertices
+Permutation::Permutation(int n)
+{
+    this->n = n;
+    newIds = new int[n];
+    oldIds = new int[n];
+    for (int i = 0; i < n; i++)
+    {
+        newIds[i] = i;
+        oldIds[i] = i;
+    }
+}
+
+// Destructor that frees both maps
+Permutation::~Permutation()
+{
+    delete[] newIds;
+    delete[] oldIds;
+}
+
+// Move constructor, other is left empty
+Permutation::Permutation(Permutation &&other) noexcept
+{
+    n = other.n;
+    newIds = other.newIds;
+    oldIds = other.oldIds;
+    other.n = 0;
+    other.newIds = nullptr;
+    other.oldIds = nullptr;
+}
+
+// Sets both directions of the map for one vertex
+void Permutation::assign(int oldId, int newId)
+{
+    newIds[oldId] = newId;
+    oldIds[newId] = oldId;
+}
+
+// Number of vertices
+int Permutation::size() const
+{
+    return n;
+}
+
+// New id of a vertex of the original graph
+int Permutation::toNew(int oldId) const
+{
+    if (oldId < 0 || oldId >= n)
+    {
+        throw std::out_of_range("toNew: Vertex index out of bounds");
+    }
+    return newIds[oldId];
+}
+
+// Original id of a vertex of the renumbered graph
+int Permutation::toOld(int newId) const
+{
+    if (newId < 0 || newId >= n)
+    {
+        throw std::out_of_range("toOld: Vertex index out of bounds");
+    }
+    return oldIds[newId];
+}
+
+// The forward map, newIds[old id]
+const int *Permutation::getNewIds() const
+{
+    return newIds;
+}
+
+// Reorders per-vertex values from new ids back to original ids
+void Permutation::toOriginalOrder(const int *byNew, int *byOld) const
+{
+    for (int v = 0; v < n; v++)
+    {
+        byOld[v] = byNew[newIds[v]];
+    }
+}
+
+// ===== Reordering Implementation =====
+
+// All vertices sorted by degree with a counting sort (ties keep id order).
+// Returns a new array the caller frees.
+int *Reordering::verticesByDegree(const Graph &g, bool ascending)
+{
+    int n = g.getNumVertices();
+    int maxDegree = 0;
+    for (int v = 0; v < n; v++)
+    {
+        maxDegree = std::max(maxDegree, g.getDegree(v));
+    }
+    int *start = new int[maxDegree + 2];
+    for (int d = 0; d <= maxDegree + 1; d++)
+    {
+        start[d] = 0;
+    }
+    for (int v = 0; v < n; v++)
+    {
+        int d = g.getDegree(v);
+        start[(ascending ? d : maxDegree - d) + 1]++;
+    }
+    for (int d = 0; d <= maxDegree; d++)
+    {
+        start[d + 1] += start[d];
+    }
+    int *order = new int[n];
+    for (int v = 0; v < n; v++)
+    {
+        int d = g.getDegree(v);
+        order[start[ascending ? d : maxDegree - d]++] = v;
+    }
+    delete[] start;
+    return order;
+}
+
+// Hubs first: the vertices most neighbor lists point at share the first cache lines
+Permutation Reordering::degreeOrder(const Graph &g)
+{
+    int n = g.getNumVertices();
+    int *order = verticesByDegree(g, false);
+    Permutation p(n);
+    for (int i = 0; i < n; i++)
+    {
+        p.assign(order[i], i);
+    }
+    delete[] order;
+    return p;
+}
+
+// Numbers vertices in the order a BFS from s finds them, so each BFS level
+// and the neighbors of a vertex get nearby ids. Other components follow by id.
+Permutation Reordering::bfsOrder(const Graph &g, int s)
+{
+    int n = g.getNumVertices();
+    if (s < 0 || s >= n)
+    {
+        throw std::out_of_range("bfsOrder: Source vertex index out of bounds");
+    }
+    Permutation p(n);
+    Bitset visited(n);
+    Queue q(n);
+    int next = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int root = (s + i) % n;
+        if (visited.testAndSet(root))
+        {
+            continue;
+        }
+        q.enqueue(root);
+        while (!q.isEmpty())
+        {
+            int u = q.dequeue();
+            p.assign(u, next++);
+            g.forEachAdjacent(u, [&](int v) {
+                if (!visited.testAndSet(v))
+                {
+                    q.enqueue(v);
+                }
+                return true;
+            });
+        }
+    }
+    return p;
+}
+
+// Reverse Cuthill-McKee: BFS from a low degree vertex of each component,
+// visiting the new neighbors of every vertex in increasing degree, then the
+// whole order reversed. Keeps the ids of neighbors close together (small bandwidth).
+Permutation Reordering::reverseCuthillMcKee(const Graph &g)
+{
+    int n = g.getNumVertices();
+    int *starts = verticesByDegree(g, true);
+    int *order = new int[n];   // doubles as the BFS queue
+    Bitset visited(n);
+
+    int tail = 0;
+    for (int i = 0; i < n; i++)
+    {
+        int root = starts[i];
+        if (visited.testAndSet(root))
+        {
+            continue;
+        }
+        int head = tail;
+        order[tail++] = root;
+        while (head < tail)
+        {
+            int u = order[head++];
+            int first = tail;
+            g.forEachAdjacent(u, [&](int v) {
+                if (!visited.testAndSet(v))
+                {
+                    order[tail++] = v;
+                }
+                return true;
+            });
+            std::sort(order + first, order + tail, [&](int a, int b) {
+                return g.getDegree(a) != g.getDegree(b) ? g.getDegree(a) < g.getDegree(b) : a < b;
+            });
+        }
+    }
+
+    Permutation p(n);
+    for (int i = 0; i < n; i++)
+    {
+        p.assign(order[i], n - 1 - i);
+    }
+    delete[] starts;
+    delete[] order;
+    return p;
+}
+
+// Builds the renumbered graph; its nodes are laid out in the new vertex order
+Graph Reordering::apply(const Graph &g, const Permutation &p)
+{
+    if (p.size() != g.getNumVertices())
+    {
+        throw std::invalid_argument("apply: Permutation size does not match the graph");
+    }
+    return g.renumbered(p.getNewIds());
+}
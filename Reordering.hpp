@@ -0,0 +1,42 @@
+#ifndef _REORDERING_HPP_
+#define _REORDERING_HPP_
+#include "Graph.hpp"
+
+namespace graph{
+
+    // A relabeling of the vertices, stored both ways so results computed on the
+    // renumbered graph can be translated back to the original ids
+    class Permutation{
+        friend class Reordering;
+        private:
+            int n;
+            int* newIds; // newIds[old id]
+            int* oldIds; // oldIds[new id]
+            void assign(int oldId, int newId);
+        public:
+            Permutation(int n); // identity
+            ~Permutation();
+            Permutation(const Permutation&) = delete;
+            Permutation& operator=(const Permutation&) = delete;
+            Permutation(Permutation&& other) noexcept;
+            int size() const;
+            int toNew(int oldId) const;
+            int toOld(int newId) const;
+            const int* getNewIds() const; // the whole forward map
+            // byOld[v] = byNew[toNew(v)], e.g. to turn distances or labels back to original ids
+            void toOriginalOrder(const int* byNew, int* byOld) const;
+    };
+
+    // Vertex orders that put vertices used together next to each other, so
+    // traversals of the renumbered graph hit fewer cache lines
+    class Reordering{
+        public:
+            static Permutation degreeOrder(const Graph& g); // highest degree first
+            static Permutation bfsOrder(const Graph& g, int s); // BFS visit order from s, then the other components
+            static Permutation reverseCuthillMcKee(const Graph& g); // small bandwidth order
+            static Graph apply(const Graph& g, const Permutation& p); // the renumbered graph
+        private:
+            static int* verticesByDegree(const Graph& g, bool ascending);
+    };
+}
+#endif
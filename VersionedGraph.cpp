@@ -0,0 +1,338 @@
+#include "VersionedGraph.hpp"
+#include <stdexcept>
+#include <string>
+using namespace graph;
+
+// ===== AdjacencyBlock Implementation =====
+
+// Empty block with room for capacity neighbors
+AdjacencyBlock::AdjacencyBlock(int capacity, unsigned long long version)
+{
+    this->degree = 0;
+    this->capacity = capacity;
+    this->vertices = new int[capacity];
+    this->weights = new int[capacity];
+    this->version = version;
+}
+
+// Destructor that frees the neighbor arrays
+AdjacencyBlock::~AdjacencyBlock()
+{
+    delete[] vertices;
+    delete[] weights;
+}
+
+// ===== GraphSnapshot Implementation =====
+
+// Empty graph: every page exists but holds no blocks
+GraphSnapshot::GraphSnapshot(int n, bool directed, unsigned long long version)
+{
+    this->n = n;
+    this->directed = directed;
+    this->edgeCount = 0;
+    this->negativeCount = 0;
+    this->version = version;
+    this->pageCount = (n + PAGE_SIZE - 1) / PAGE_SIZE;
+    this->pages = new std::shared_ptr<VertexPage>[pageCount];
+    for (int i = 0; i < pageCount; i++)
+    {
+        pages[i] = std::make_shared<VertexPage>();
+        pages[i]->version = version;
+    }
+}
+
+// New version sharing every page of base, O(n / PAGE_SIZE)
+GraphSnapshot::GraphSnapshot(const GraphSnapshot &base, unsigned long long version)
+{
+    this->n = base.n;
+    this->directed = base.directed;
+    this->edgeCount = base.edgeCount;
+    this->negativeCount = base.negativeCount;
+    this->version = version;
+    this->pageCount = base.pageCount;
+    this->pages = new std::shared_ptr<VertexPage>[pageCount];
+    for (int i = 0; i < pageCount; i++)
+    {
+        pages[i] = base.pages[i];
+    }
+}
+
+// Destructor, pages and blocks still used by other versions stay alive
+GraphSnapshot::~GraphSnapshot()
+{
+    delete[] pages;
+}
+
+// Getter for number of vertices
+int GraphSnapshot::getNumVertices() const
+{
+    return n;
+}
+
+// True if edges only go from u to v
+bool GraphSnapshot::isDirected() const
+{
+    return directed;
+}
+
+// True if any edge weight is negative
+bool GraphSnapshot::getIsNegative() const
+{
+    return negativeCount > 0;
+}
+
+// Getter for the number of edges
+int GraphSnapshot::getEdgeCount() const
+{
+    return edgeCount;
+}
+
+// Version number, grows with every publish
+unsigned long long GraphSnapshot::getVersion() const
+{
+    return version;
+}
+
+// Number of neighbors of u (out-degree if directed)
+int GraphSnapshot::getDegree(int u) const
+{
+    if (u < 0 || u >= n)
+    {
+        throw std::out_of_range("getDegree: Vertex index out of bounds");
+    }
+    const AdjacencyBlock *b = block(u);
+    return b == nullptr ? 0 : b->degree;
+}
+
+// ===== VersionedGraph Implementation =====
+
+// Empty graph, published as version 1
+VersionedGraph::VersionedGraph(int n, bool directed)
+{
+    published = std::shared_ptr<const GraphSnapshot>(new GraphSnapshot(n, directed, 1));
+}
+
+// Copies every edge of g into version 1
+VersionedGraph::VersionedGraph(const Graph &g)
+{
+    int n = g.getNumVertices();
+    draft = std::shared_ptr<GraphSnapshot>(new GraphSnapshot(n, g.isDirected(), 1));
+    Node **adj = g.getAdjList();
+    for (int u = 0; u < n; u++)
+    {
+        Node *curr = adj[u];
+        while (curr != nullptr)
+        {
+            appendNeighbor(u, curr->vertex, curr->weight);
+            curr = curr->next;
+        }
+    }
+    // both counters are kept by g, no second pass over the lists
+    draft->edgeCount = g.getEdgeCount();
+    draft->negativeCount = g.getNegativeCount();
+    std::atomic_store(&published, std::shared_ptr<const GraphSnapshot>(draft));
+    draft = nullptr;
+}
+
+// Returns the latest published version
+std::shared_ptr<const GraphSnapshot> VersionedGraph::snapshot() const
+{
+    return std::atomic_load(&published);
+}
+
+// The writer's draft, started from the published version on the first change
+GraphSnapshot &VersionedGraph::writable()
+{
+    if (draft == nullptr)
+    {
+        std::shared_ptr<const GraphSnapshot> base = std::atomic_load(&published);
+        draft = std::shared_ptr<GraphSnapshot>(new GraphSnapshot(*base, base->version + 1));
+    }
+    return *draft;
+}
+
+// The block of u in the draft, copying its page and block if they are still shared
+AdjacencyBlock &VersionedGraph::writableBlock(int u)
+{
+    GraphSnapshot &d = writable();
+    std::shared_ptr<VertexPage> &page = d.pages[u >> PAGE_BITS];
+    if (page->version != d.version)
+    {
+        std::shared_ptr<VertexPage> copy = std::make_shared<VertexPage>(*page);
+        copy->version = d.version;
+        page = copy;
+    }
+    std::shared_ptr<AdjacencyBlock> &slot = page->blocks[u & (PAGE_SIZE - 1)];
+    if (slot == nullptr)
+    {
+        slot = std::make_shared<AdjacencyBlock>(4, d.version);
+    }
+    else if (slot->version != d.version)
+    {
+        const AdjacencyBlock &old = *slot;
+        int capacity = old.degree < 2 ? 4 : old.degree * 2;
+        std::shared_ptr<AdjacencyBlock> copy = std::make_shared<AdjacencyBlock>(capacity, d.version);
+        for (int i = 0; i < old.degree; i++)
+        {
+            copy->vertices[i] = old.vertices[i];
+            copy->weights[i] = old.weights[i];
+        }
+        copy->degree = old.degree;
+        slot = copy;
+    }
+    return *slot;
+}
+
+// Adds v to the neighbors of u, growing the draft block when it is full
+void VersionedGraph::appendNeighbor(int u, int v, int w)
+{
+    AdjacencyBlock &b = writableBlock(u);
+    if (b.degree == b.capacity)
+    {
+        int *vertices = new int[b.capacity * 2];
+        int *weights = new int[b.capacity * 2];
+        for (int i = 0; i < b.degree; i++)
+        {
+            vertices[i] = b.vertices[i];
+            weights[i] = b.weights[i];
+        }
+        delete[] b.vertices;
+        delete[] b.weights;
+        b.vertices = vertices;
+        b.weights = weights;
+        b.capacity *= 2;
+    }
+    b.vertices[b.degree] = v;
+    b.weights[b.degree] = w;
+    b.degree++;
+}
+
+// Removes one v from the neighbors of u (the last neighbor fills the hole)
+bool VersionedGraph::removeNeighbor(int u, int v, int &weight)
+{
+    const AdjacencyBlock *shared = writable().block(u);
+    if (shared == nullptr)
+    {
+        return false;
+    }
+    int i = 0;
+    while (i < shared->degree && shared->vertices[i] != v)
+    {
+        i++;
+    }
+    if (i == shared->degree)
+    {
+        return false; // nothing to change, so nothing is copied
+    }
+    AdjacencyBlock &b = writableBlock(u);
+    weight = b.weights[i];
+    b.degree--;
+    b.vertices[i] = b.vertices[b.degree];
+    b.weights[i] = b.weights[b.degree];
+    return true;
+}
+
+// Sets the weight of one v among the neighbors of u, skipping the first skip matches
+bool VersionedGraph::setNeighborWeight(int u, int v, int w, int skip, int &oldWeight)
+{
+    const AdjacencyBlock *shared = writable().block(u);
+    if (shared == nullptr)
+    {
+        return false;
+    }
+    int i = 0;
+    while (i < shared->degree && (shared->vertices[i] != v || skip-- > 0))
+    {
+        i++;
+    }
+    if (i == shared->degree)
+    {
+        return false;
+    }
+    AdjacencyBlock &b = writableBlock(u);
+    oldWeight = b.weights[i];
+    b.weights[i] = w;
+    return true;
+}
+
+// Throws if u or v is not a vertex
+void VersionedGraph::checkVertices(int u, int v, const char *who) const
+{
+    int n = std::atomic_load(&published)->n;
+    if (u < 0 || u >= n || v < 0 || v >= n)
+    {
+        throw std::out_of_range(std::string(who) + ": Vertex index out of bounds");
+    }
+}
+
+// Adds an edge to the draft
+void VersionedGraph::addEdge(int u, int v, int w)
+{
+    checkVertices(u, v, "addEdge");
+    GraphSnapshot &d = writable();
+    appendNeighbor(u, v, w);
+    if (!d.directed)
+    {
+        appendNeighbor(v, u, w);
+    }
+    d.edgeCount++;
+    if (w < 0)
+    {
+        d.negativeCount++;
+    }
+}
+
+// Removes an edge from the draft, false if there is none
+bool VersionedGraph::removeEdge(int u, int v)
+{
+    checkVertices(u, v, "removeEdge");
+    GraphSnapshot &d = writable();
+    int weight = 0;
+    int otherWeight = 0;
+    if (!removeNeighbor(u, v, weight))
+    {
+        return false;
+    }
+    if (!d.directed)
+    {
+        removeNeighbor(v, u, otherWeight);
+    }
+    d.edgeCount--;
+    if (weight < 0)
+    {
+        d.negativeCount--;
+    }
+    return true;
+}
+
+// Changes the weight of an edge in the draft, false if there is none
+bool VersionedGraph::updateWeight(int u, int v, int w)
+{
+    checkVertices(u, v, "updateWeight");
+    GraphSnapshot &d = writable();
+    int oldWeight = 0;
+    int otherWeight = 0;
+    if (!setNeighborWeight(u, v, w, 0, oldWeight))
+    {
+        return false;
+    }
+    if (!d.directed)
+    {
+        // an undirected self loop is stored twice in the same block
+        setNeighborWeight(v, u, w, u == v ? 1 : 0, otherWeight);
+    }
+    d.negativeCount += (w < 0) - (oldWeight < 0);
+    return true;
+}
+
+// Makes the draft the version new readers get.
+// Readers still holding older versions keep them until they let go.
+std::shared_ptr<const GraphSnapshot> VersionedGraph::publish()
+{
+    if (draft != nullptr)
+    {
+        std::atomic_store(&published, std::shared_ptr<const GraphSnapshot>(draft));
+        draft = nullptr;
+    }
+    return std::atomic_load(&published);
+}
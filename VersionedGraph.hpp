@@ -0,0 +1,105 @@
+#ifndef _VERSIONED_GRAPH_HPP_
+#define _VERSIONED_GRAPH_HPP_
+#include <memory>
+#include "Graph.hpp"
+
+namespace graph{
+
+    // Neighbors of one vertex inside a snapshot.
+    // Only the draft whose version matches may still change it; once published it is read only.
+    struct AdjacencyBlock{
+        int degree;
+        int capacity;
+        int* vertices;
+        int* weights;
+        unsigned long long version;
+        AdjacencyBlock(int capacity, unsigned long long version);
+        ~AdjacencyBlock();
+    };
+
+    // Vertices are grouped in pages so a new version copies one pointer per page,
+    // not one per vertex, and only the pages that really changed
+    const int PAGE_BITS = 6;
+    const int PAGE_SIZE = 1 << PAGE_BITS;
+
+    struct VertexPage{
+        std::shared_ptr<AdjacencyBlock> blocks[PAGE_SIZE]; // nullptr = no neighbors yet
+        unsigned long long version;
+    };
+
+    // An immutable version of the graph. Readers keep it alive through the
+    // shared_ptr they got from VersionedGraph::snapshot(), whatever the writer does.
+    class GraphSnapshot{
+        friend class VersionedGraph;
+        private:
+            int n;
+            bool directed;
+            int edgeCount;
+            int negativeCount;
+            unsigned long long version;
+            int pageCount;
+            std::shared_ptr<VertexPage>* pages;
+            GraphSnapshot(int n, bool directed, unsigned long long version);
+            GraphSnapshot(const GraphSnapshot& base, unsigned long long version); // shares all pages of base
+            const AdjacencyBlock* block(int u) const
+            {
+                return pages[u >> PAGE_BITS]->blocks[u & (PAGE_SIZE - 1)].get();
+            }
+        public:
+            ~GraphSnapshot();
+            int getNumVertices() const;
+            bool isDirected() const;
+            bool getIsNegative() const;
+            int getEdgeCount() const;
+            unsigned long long getVersion() const;
+            int getDegree(int u) const;
+            // Calls f(v, w) for every edge (u, v, w) until f returns false
+            template <class F> bool forEachNeighbor(int u, F f) const
+            {
+                const AdjacencyBlock* b = block(u);
+                if (b == nullptr) return true;
+                for (int i = 0; i < b->degree; i++)
+                {
+                    if (!f(b->vertices[i], b->weights[i])) return false;
+                }
+                return true;
+            }
+            // Calls f(v) for every edge (u, v) until f returns false; the weights array is not read
+            template <class F> bool forEachAdjacent(int u, F f) const
+            {
+                const AdjacencyBlock* b = block(u);
+                if (b == nullptr) return true;
+                for (int i = 0; i < b->degree; i++)
+                {
+                    if (!f(b->vertices[i])) return false;
+                }
+                return true;
+            }
+    };
+
+    // A graph with one writer and any number of concurrent readers (MVCC).
+    // The writer changes a private draft: the first change to a vertex copies its
+    // page and its block, everything else stays shared with the published version.
+    // publish() makes the draft visible; readers never wait for the writer.
+    // addEdge/removeEdge/updateWeight/publish must all be called from one thread.
+    class VersionedGraph{
+        private:
+            std::shared_ptr<const GraphSnapshot> published;
+            std::shared_ptr<GraphSnapshot> draft; // nullptr until the first change after publish()
+            GraphSnapshot& writable();
+            AdjacencyBlock& writableBlock(int u);
+            void appendNeighbor(int u, int v, int w);
+            bool removeNeighbor(int u, int v, int& weight);
+            bool setNeighborWeight(int u, int v, int w, int skip, int& oldWeight);
+            void checkVertices(int u, int v, const char* who) const;
+        public:
+            VersionedGraph(int n, bool directed = false);
+            VersionedGraph(const Graph& g); // starts from a copy of g, published as version 1
+            std::shared_ptr<const GraphSnapshot> snapshot() const; // safe from any thread
+            void addEdge(int u, int v, int w);
+            bool removeEdge(int u, int v);
+            bool updateWeight(int u, int v, int w);
+            std::shared_ptr<const GraphSnapshot> publish(); // returns the new version
+    };
+}
+#endif
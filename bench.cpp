@@ -0,0 +1,221 @@
+#include "Graph.hpp"
+#include "Algorithms.hpp"
+#include "DataStructures.hpp"
+#include <chrono>
+#include <cstdio>
+using namespace graph;
+
+// Times small edge batches on a big graph, compares BFS on the compressed
+// graph with CSR, and the priority queues of dijkstra and prim (binary heap,
+// pairing heap and lazy heap without decrease-key) on sparse and dense graphs.
+// Build and run with: make bench
+
+static unsigned int seed = 12345;
+
+// Small LCG so every run builds the same graphs
+static int nextRandom(int bound)
+{
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % (unsigned int)bound);
+}
+
+// Random tree (so prim has a connected graph) plus extra random edges
+static Graph sparseGraph(int n, int extraEdges, int maxWeight)
+{
+    Graph g(n);
+    for (int v = 1; v < n; v++)
+    {
+        g.addEdge(v, nextRandom(v), 1 + nextRandom(maxWeight));
+    }
+    for (int i = 0; i < extraEdges; i++)
+    {
+        g.addEdge(nextRandom(n), nextRandom(n), 1 + nextRandom(maxWeight));
+    }
+    return g;
+}
+
+// Every pair is an edge with probability percent / 100
+static Graph denseGraph(int n, int percent, int maxWeight)
+{
+    Graph g(n);
+    for (int u = 0; u < n; u++)
+    {
+        g.addEdge(u, (u + 1) % n, 1 + nextRandom(maxWeight));
+        for (int v = u + 2; v < n; v++)
+        {
+            if (nextRandom(100) < percent)
+            {
+                g.addEdge(u, v, 1 + nextRandom(maxWeight));
+            }
+        }
+    }
+    return g;
+}
+
+// Sum of the tree weights, compared so the queues can be checked to agree
+static long long treeWeight(const Graph &t)
+{
+    long long total = 0;
+    for (int u = 0; u < t.getNumVertices(); u++)
+    {
+        for (Node *curr = t.getAdjList()[u]; curr != nullptr; curr = curr->next)
+        {
+            total += curr->weight;
+        }
+    }
+    return total / 2;
+}
+
+// Sum of the distances from s along the shortest-path tree t (ties may pick other trees)
+static long long distanceSum(const Graph &t, int s)
+{
+    Workspace ws(t.getNumVertices());
+    Algorithms::dijkstra(t, s, ws);
+    long long total = 0;
+    for (int v = 0; v < t.getNumVertices(); v++)
+    {
+        total += ws.getDistance(v);
+    }
+    return total;
+}
+
+// Best of reps runs of dijkstra with queue PQ, in milliseconds
+template <class PQ>
+static double timeDijkstra(const Graph &g, int reps, long long &weight)
+{
+    double best = 1e18;
+    for (int r = 0; r < reps; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Graph tree = Algorithms::dijkstra<PQ>(g, r % g.getNumVertices());
+        std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        best = took.count() < best ? took.count() : best;
+        weight = distanceSum(tree, r % g.getNumVertices());
+    }
+    return best;
+}
+
+// Best of reps runs of prim with queue PQ, in milliseconds
+template <class PQ>
+static double timePrim(const Graph &g, int reps, long long &weight)
+{
+    double best = 1e18;
+    for (int r = 0; r < reps; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Graph tree = Algorithms::prim<PQ>(g, r % g.getNumVertices());
+        std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        best = took.count() < best ? took.count() : best;
+        weight = treeWeight(tree);
+    }
+    return best;
+}
+
+// Prints one table row: the time of each queue relative to the binary heap
+static void printRow(const char *algorithm, const double *ms, const long long *weights)
+{
+    printf("  %-9s binary %9.2f ms   pairing %9.2f ms (%.2fx)   lazy %9.2f ms (%.2fx)%s\n", algorithm, ms[0], ms[1],
+           ms[0] / ms[1], ms[2], ms[0] / ms[2],
+           weights[0] == weights[1] && weights[0] == weights[2] ? "" : "  MISMATCH");
+}
+
+// One table row per algorithm for graph g
+static void run(const char *name, const Graph &g, int reps)
+{
+    double ms[3];
+    long long weights[3];
+    printf("%s: %d vertices, %d edges\n", name, g.getNumVertices(), g.getEdgeCount());
+    ms[0] = timeDijkstra<MinPriorityQueue>(g, reps, weights[0]);
+    ms[1] = timeDijkstra<PairingHeap>(g, reps, weights[1]);
+    ms[2] = timeDijkstra<LazyMinHeap>(g, reps, weights[2]);
+    printRow("dijkstra", ms, weights);
+    ms[0] = timePrim<MinPriorityQueue>(g, reps, weights[0]);
+    ms[1] = timePrim<PairingHeap>(g, reps, weights[1]);
+    ms[2] = timePrim<LazyMinHeap>(g, reps, weights[2]);
+    printRow("prim", ms, weights);
+}
+
+// Best of reps BFS runs on the representation G, in milliseconds
+template <class G>
+static double timeBfs(const G &g, int reps, Workspace &ws)
+{
+    double best = 1e18;
+    for (int r = 0; r < reps; r++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Algorithms::bfs(g, r % g.getNumVertices(), ws);
+        std::chrono::duration<double, std::milli> took = std::chrono::steady_clock::now() - start;
+        best = took.count() < best ? took.count() : best;
+    }
+    return best;
+}
+
+// BFS on the compressed graph against CSR, plus the memory of each
+static void runStorage(const char *name, const Graph &g, int reps)
+{
+    CompactGraph csr(g);
+    CompressedGraph packed(g);
+    Workspace ws(g.getNumVertices());
+    double plain = timeBfs(csr, reps, ws);
+    double compressed = timeBfs(packed, reps, ws);
+    printf("%s: %d vertices, %d edges\n", name, g.getNumVertices(), g.getEdgeCount());
+    printf("  %-9s csr %9.2f ms (%.2f B/edge)   compressed %9.2f ms (%.2f B/edge, %.2fx slower)\n", "bfs", plain,
+           (double)csr.getMemoryBytes() / g.getEdgeCount(), compressed, packed.getBytesPerEdge(), compressed / plain);
+}
+
+// Every vertex gets up to perVertex edges to the next window vertices, like a reordered graph
+static Graph localGraph(int n, int perVertex, int window, int maxWeight)
+{
+    Graph g(n);
+    for (int u = 0; u < n; u++)
+    {
+        for (int k = 0; k < perVertex; k++)
+        {
+            int v = u + 1 + nextRandom(window);
+            if (v < n)
+            {
+                g.addEdge(u, v, 1 + nextRandom(maxWeight));
+            }
+        }
+    }
+    return g;
+}
+
+// Many small removeEdges/updateWeights batches on a big graph: the cost per batch
+// should follow the batch size, not the number of vertices
+static void runSmallBatches(int n, int batches, int batchSize)
+{
+    Graph g = sparseGraph(n, 2 * n, 20);
+    Edge *batch = new Edge[batchSize];
+    auto start = std::chrono::steady_clock::now();
+    for (int b = 0; b < batches; b++)
+    {
+        for (int i = 0; i < batchSize; i++)
+        {
+            int v = 1 + nextRandom(n - 1);
+            batch[i] = Edge(v, g.getAdjList()[v]->vertex, 1 + nextRandom(20));
+        }
+        g.updateWeights(batch, batchSize);
+        g.removeEdges(batch, batchSize);
+        for (int i = 0; i < batchSize; i++)
+        {
+            g.addEdge(batch[i].u, batch[i].v, batch[i].weight);
+        }
+    }
+    std::chrono::duration<double, std::micro> took = std::chrono::steady_clock::now() - start;
+    printf("small batches: %d vertices, %d batches of %d edges\n", n, batches, batchSize);
+    printf("  %-9s %9.2f us per reweigh + remove batch\n", "batch", took.count() / batches);
+    delete[] batch;
+}
+
+int main()
+{
+    runSmallBatches(1000000, 20000, 4);
+    runStorage("local (avg degree 16)", localGraph(200000, 8, 100, 10), 5);
+    runStorage("random (avg degree 8)", sparseGraph(200000, 600000, 20), 5);
+    // Weights stay small: the algorithms use 9999 as infinity
+    run("sparse (avg degree 8)", sparseGraph(100000, 300000, 20), 3);
+    run("dense (50% of pairs)", denseGraph(2000, 50, 1000), 3);
+    run("complete", denseGraph(2500, 100, 1000), 3);
+    return 0;
+}
@@ -3,6 +3,14 @@
 #include "Graph.hpp"
 #include "Algorithms.hpp"
 #include "DataStructures.hpp"
+#include "VersionedGraph.hpp"
+#include "Reordering.hpp"
+#include "Intersection.hpp"
+#include "IncrementalConnectivity.hpp"
+#include "DynamicMST.hpp"
+#include "DynamicSSSP.hpp"
+#include <atomic>
+#include <thread>
 using namespace graph;
 // Function to check if an edge exists in the graph
 bool hasEdge(const Graph& g, int u, int v, int w = -1) {
@@ -17,6 +25,28 @@ bool hasEdge(const Graph& g, int u, int v, int w = -1) {
     }
     return false;
 }
+
+// Small LCG so the random tests see the same numbers on every run: 0..bound-1
+int nextRandom(unsigned int &seed, int bound) {
+    seed = seed * 1103515245 + 12345;
+    return (int)((seed >> 8) % (unsigned int)bound);
+}
+
+// Connected undirected graph: a random tree plus extraEdges random edges, weights 1..maxWeight
+Graph randomConnectedGraph(int n, int extraEdges, int maxWeight, unsigned int seed) {
+    Graph g(n);
+    for (int v = 1; v < n; v++) g.addEdge(v, nextRandom(seed, v), 1 + nextRandom(seed, maxWeight));
+    for (int i = 0; i < extraEdges; i++) g.addEdge(nextRandom(seed, n), nextRandom(seed, n), 1 + nextRandom(seed, maxWeight));
+    return g;
+}
+
+// Sum of the weights of an undirected graph, every edge counted once
+long long totalWeight(const Graph &g) {
+    long long sum = 0;
+    for (int u = 0; u < g.getNumVertices(); u++)
+        for (Node *curr = g.getAdjList()[u]; curr != nullptr; curr = curr->next) sum += curr->weight;
+    return sum / 2;
+}
 //test to check if the queue is working
 TEST_CASE("Queue") {
     Queue q(5);
@@ -36,14 +66,118 @@ TEST_CASE("Queue") {
     q.enqueue(7);
     q.enqueue(8);
     q.enqueue(9);
-    CHECK(q.isFull());
+    CHECK(q.getCapacity() == 8);          // 5 rounded up to a power of two
+    CHECK_FALSE(q.isFull());
     CHECK(q.dequeue() == 5);
     CHECK(q.dequeue() == 6);
     CHECK(q.dequeue() == 7);
     CHECK(q.dequeue() == 8);
     CHECK(q.dequeue() == 9);
     CHECK(q.isEmpty());
-    
+    CHECK_THROWS_AS(q.dequeue(), std::underflow_error);
+}
+//test to check that the queue grows instead of dropping values, also in bulk
+TEST_CASE("Queue growth and bulk operations") {
+    Queue q(4);
+    for (int i = 0; i < 3; i++) q.enqueue(i);
+    q.dequeue();
+    q.dequeue();                          // the front is now in the middle of the buffer
+    for (int i = 3; i < 6; i++) q.enqueue(i);
+    CHECK(q.isFull());
+    q.enqueue(6);                         // wraps around and doubles
+    CHECK(q.getCapacity() == 8);
+    CHECK(q.getSize() == 5);
+    for (int i = 2; i <= 6; i++) CHECK(q.dequeue() == i);
+
+    int values[100];
+    for (int i = 0; i < 100; i++) values[i] = i;
+    q.enqueue(-1);
+    q.pushBulk(values, 100);
+    CHECK(q.getCapacity() == 128);
+    CHECK(q.contains(99));
+    int out[64];
+    CHECK(q.popBulk(out, 64) == 64);
+    CHECK(out[0] == -1);
+    CHECK(out[63] == 62);
+    CHECK(q.popBulk(out, 64) == 37);
+    CHECK(out[36] == 99);
+    CHECK(q.isEmpty());
+    q.pushBulk(values, 0);
+    CHECK(q.isEmpty());
+}
+//test to check that the indexed queue keeps each id once and answers contains right away
+TEST_CASE("IndexedQueue") {
+    IndexedQueue q(5);
+    CHECK(q.enqueue(3));
+    CHECK(q.enqueue(1));
+    CHECK_FALSE(q.enqueue(3));            // already waiting
+    CHECK(q.getSize() == 2);
+    CHECK(q.contains(3));
+    CHECK_FALSE(q.contains(4));
+    CHECK(q.dequeue() == 3);
+    CHECK_FALSE(q.contains(3));
+    CHECK(q.enqueue(3));                  // may come back once it left
+    for (int v = 0; v < 5; v++) q.enqueue(v);
+    CHECK(q.getSize() == 5);              // never more than one entry per id
+    q.clear();
+    CHECK(q.isEmpty());
+    CHECK_FALSE(q.contains(1));
+    CHECK_THROWS_AS(q.enqueue(5), std::out_of_range);
+    CHECK_THROWS_AS(q.dequeue(), std::underflow_error);
+}
+//test to check the bitset word operations and the bitmap frontier BFS
+TEST_CASE("Bitset") {
+    Bitset a(200), b(200);
+    CHECK_FALSE(a.any());
+    CHECK(a.findNext(0) == -1);
+    a.set(3);
+    a.set(64);
+    a.set(199);
+    CHECK(a.test(64));
+    CHECK_FALSE(a.test(65));
+    CHECK(a.count() == 3);
+    CHECK(a.findNext(0) == 3);
+    CHECK(a.findNext(4) == 64);
+    CHECK(a.findNext(65) == 199);
+    CHECK(a.findNext(200) == -1);
+    CHECK(a.testAndSet(3));
+    CHECK_FALSE(a.testAndSet(100));
+    a.reset(100);
+    b.setAll();
+    CHECK(b.count() == 200);                // no stray bits past the end
+    b.andNot(a);
+    CHECK(b.count() == 197);
+    CHECK_FALSE(b.test(199));
+    b.orWith(a);
+    CHECK(b.count() == 200);
+    b.andWith(a);
+    CHECK(b.count() == 3);
+    b.clear();
+    a.swap(b);
+    CHECK_FALSE(a.any());
+    CHECK(b.count() == 3);
+    Bitset small(10);
+    CHECK_THROWS_AS(a.orWith(small), std::invalid_argument);
+    CHECK_THROWS_AS(Bitset(-1), std::invalid_argument);
+
+    Graph g(300);
+    unsigned int seed = 11;
+    for (int i = 0; i < 400; i++) g.addEdge(nextRandom(seed, 300), nextRandom(seed, 300), 1);
+    CompactGraph cg(g);
+    int *level = new int[300];
+    int levels = Algorithms::bfsLevels(cg, 0, level);
+    Workspace ws(300);
+    Algorithms::bfs(g, 0, ws);
+    bool same = true;
+    int deepest = 0;
+    for (int v = 0; v < 300; v++) {
+        same = same && level[v] == (ws.isReached(v) ? ws.getDistance(v) : -1);
+        deepest = std::max(deepest, level[v]);
+    }
+    CHECK(same);
+    CHECK(levels == deepest + 1);
+    CHECK_THROWS_AS(Algorithms::bfsLevels(cg, 300, level), std::out_of_range);
+    delete[] level;
 }
 //test to check if the union find is working
 TEST_CASE("UnionFind") {
@@ -135,6 +269,118 @@ TEST_CASE("MinPriorityQueue") {
     CHECK(min.distance == 20);
     CHECK(mpq.isEmpty());
 }
+//test to check the pairing heap against the binary heap and inside dijkstra and prim
+TEST_CASE("PairingHeap") {
+    PairingHeap ph(6);
+    CHECK(ph.isEmpty());
+    ph.insert(0, 10);
+    ph.insert(1, 5);
+    ph.insert(2, 20);
+    ph.insert(3, 15);
+    CHECK(ph.contains(2));
+    ph.decreaseKey(2, 1);                 // a child moves above the root
+    ph.decreaseKey(3, 30);                // larger key, ignored
+    Pair min = ph.extractMin();
+    CHECK(min.vertex == 2);
+    CHECK(min.distance == 1);
+    CHECK_FALSE(ph.contains(2));
+    CHECK(ph.extractMin().vertex == 1);
+    CHECK(ph.extractMin().vertex == 0);
+    CHECK(ph.extractMin().distance == 15);
+    CHECK(ph.isEmpty());
+    ph.insert(4, 7);
+    ph.insert(5, 3);
+    ph.clear();
+    CHECK(ph.isEmpty());
+    CHECK_FALSE(ph.contains(4));
+
+    PairingHeap big(500);
+    MinPriorityQueue reference(500);
+    unsigned int seed = 5;
+    bool same = true;
+    for (int step = 0; step < 5000; step++) {
+        int v = nextRandom(seed, 500), op = nextRandom(seed, 3);
+        if (op == 0 && !big.contains(v)) {
+            int d = nextRandom(seed, 1000) + 1000;
+            big.insert(v, d);
+            reference.insert(v, d);
+        } else if (op == 1 && big.contains(v)) {
+            int d = nextRandom(seed, 1000);
+            big.decreaseKey(v, d);
+            reference.decreaseKey(v, d);
+        } else if (op == 2 && !big.isEmpty()) {
+            same = same && big.extractMin().distance == reference.extractMin().distance;
+        }
+        same = same && big.isEmpty() == reference.isEmpty();
+    }
+    CHECK(same);
+
+    Graph g = randomConnectedGraph(60, 400, 50, 9);
+    CHECK(totalWeight(Algorithms::prim<PairingHeap>(g, 0)) == totalWeight(Algorithms::prim(g, 0)));
+    Graph tree = Algorithms::dijkstra<PairingHeap>(g, 0);
+    Workspace onTree(60), onGraph(60);
+    Algorithms::dijkstra(tree, 0, onTree);
+    Algorithms::dijkstra(g, 0, onGraph);
+    same = true;
+    for (int v = 0; v < 60; v++) same = same && onTree.getDistance(v) == onGraph.getDistance(v);
+    CHECK(same);
+}
+//test to check the lazy heap keeps duplicates, grows past its capacity and that dijkstra and prim skip the stale entries
+TEST_CASE("LazyMinHeap") {
+    LazyMinHeap lh(2);
+    CHECK(lh.isEmpty());
+    lh.insert(0, 10);
+    lh.insert(1, 5);
+    CHECK_FALSE(lh.contains(0));          // never looked up
+    lh.decreaseKey(0, 3);                 // a second entry for 0, grows past the capacity
+    lh.insert(2, 20);
+    CHECK(lh.getSize() == 4);
+    Pair min = lh.extractMin();
+    CHECK(min.vertex == 0);
+    CHECK(min.distance == 3);
+    CHECK(lh.extractMin().vertex == 1);
+    min = lh.extractMin();
+    CHECK(min.vertex == 0);               // the stale entry is still there
+    CHECK(min.distance == 10);
+    CHECK(lh.extractMin().distance == 20);
+    CHECK(lh.isEmpty());
+
+    // many duplicates of the same few vertices: the heap keeps doubling and still pops in order
+    LazyMinHeap dup(1);
+    for (int i = 0; i < 1000; i++) dup.insert(i % 3, (i * 7919) % 1000);
+    CHECK(dup.getSize() == 1000);
+    bool sorted = true;
+    int last = -1;
+    while (!dup.isEmpty()) {
+        int d = dup.extractMin().distance;
+        sorted = sorted && d >= last;
+        last = d;
+    }
+    CHECK(sorted);
+    dup.insert(3, 1);
+    dup.clear();
+    CHECK(dup.isEmpty());
+
+    // every vertex is improved over and over (heavy direct edges, light long paths),
+    // so the heap is full of stale entries that must not be settled a second time
+    int n = 40;
+    Graph g(n);
+    for (int v = 1; v < n; v++) {
+        g.addEdge(0, v, 1000 - v);
+        g.addEdge(v - 1, v, 1);
+        for (int u = 1; u < v; u++) g.addEdge(u, v, 500 + u);
+    }
+    Graph tree = Algorithms::dijkstra<LazyMinHeap>(g, 0);
+    CHECK(tree.getEdgeCount() == n - 1);
+    Workspace onTree(n);
+    Algorithms::dijkstra(tree, 0, onTree);
+    bool same = true;
+    for (int v = 0; v < n; v++) same = same && onTree.getDistance(v) == v;
+    CHECK(same);
+    Graph lazyMst = Algorithms::prim<LazyMinHeap>(g, n - 1);
+    CHECK(lazyMst.getEdgeCount() == n - 1);
+    CHECK(totalWeight(lazyMst) == n - 1);    // the path of weight 1 edges
+}
 //testing the sorting algorithm for kruskal
 TEST_CASE("SelectionSort") {
     Edge edges[] = {Edge(0, 1, 10), Edge(0, 2, 6), Edge(0, 3, 5), Edge(1, 3, 15), Edge(2, 3, 4)};
@@ -182,3 +428,1115 @@ TEST_CASE("Source vertex out of range") {
     CHECK_THROWS_AS(Algorithms::dijkstra(g, 3), std::out_of_range);
     CHECK_THROWS_AS(Algorithms::prim(g, -2), std::out_of_range);
 }
+
+//test to check that batched dijkstra returns one distance row per source
+TEST_CASE("Dijkstra batch") {
+    Graph g(5);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 4);
+    g.addEdge(1, 2, 2);
+    g.addEdge(2, 3, 1);
+    int sources[] = {0, 3, 4, 0};
+    int dist[4 * 5];
+    Algorithms::dijkstraBatch(g, sources, 4, dist, 3);
+    int row0[] = {0, 1, 3, 4, -1};
+    int row3[] = {4, 3, 1, 0, -1};
+    for (int v = 0; v < 5; v++) {
+        CHECK(dist[0 * 5 + v] == row0[v]);
+        CHECK(dist[1 * 5 + v] == row3[v]);
+        CHECK(dist[3 * 5 + v] == row0[v]);
+    }
+    CHECK(dist[2 * 5 + 4] == 0);
+    CHECK(dist[2 * 5 + 0] == -1);
+
+    int bad[] = {5};
+    CHECK_THROWS_AS(Algorithms::dijkstraBatch(g, bad, 1, dist), std::out_of_range);
+    g.addEdge(3, 4, -1);
+    CHECK_THROWS_AS(Algorithms::dijkstraBatch(g, sources, 4, dist), std::logic_error);
+}
+
+//test to check that a workspace can be reused between queries
+TEST_CASE("Workspace reuse") {
+    Graph g(6);
+    g.addEdge(0, 1, 7);
+    g.addEdge(1, 2, 1);
+    g.addEdge(0, 2, 9);
+    g.addEdge(4, 5, 3);
+    Workspace ws(6);
+
+    Algorithms::dijkstra(g, 0, ws);
+    CHECK(ws.getVisitedCount() == 3);
+    CHECK(ws.getDistance(2) == 8);
+    CHECK(ws.getParent(2) == 1);
+    CHECK(ws.getDistance(4) == -1);
+
+    Algorithms::bfs(g, 4, ws);
+    CHECK(ws.getVisitedCount() == 2);
+    CHECK(ws.getVisited(0) == 4);
+    CHECK(ws.getDistance(5) == 1);
+    CHECK_FALSE(ws.isReached(0));     // left over from the previous query
+
+    Algorithms::bfs(g, 0, ws);
+    CHECK(ws.getDistance(2) == 1);
+    CHECK(ws.getParent(2) == 0);
+
+    Workspace small(3);
+    CHECK_THROWS_AS(Algorithms::bfs(g, 0, small), std::invalid_argument);
+    CHECK_THROWS_AS(Algorithms::dijkstra(g, 6, ws), std::out_of_range);
+}
+
+//test to check the early exit and bounded radius limits
+TEST_CASE("Bounded traversals") {
+    Graph g(6);                       // path 0-1-2-3-4-5
+    for (int i = 0; i < 5; i++) {
+        g.addEdge(i, i + 1, 2);
+    }
+    Workspace ws(6);
+    SearchLimits limits;
+
+    limits.maxHops = 2;
+    Algorithms::bfs(g, 0, ws, limits);
+    CHECK(ws.getVisitedCount() == 3);
+    CHECK(ws.getDistance(2) == 2);
+    CHECK_FALSE(ws.isReached(3));
+
+    limits = SearchLimits();
+    limits.target = 3;
+    Algorithms::bfs(g, 0, ws, limits);
+    CHECK(ws.isSettled(3));
+    CHECK_FALSE(ws.isReached(4));
+
+    limits = SearchLimits();
+    limits.maxDistance = 5;
+    Algorithms::dijkstra(g, 0, ws, limits);
+    CHECK(ws.getVisitedCount() == 3);
+    CHECK(ws.getDistance(2) == 4);
+    CHECK_FALSE(ws.isReached(3));
+
+    limits = SearchLimits();
+    limits.maxSettled = 2;
+    Algorithms::dijkstra(g, 2, ws, limits);
+    CHECK(ws.getVisitedCount() == 2);
+    CHECK(ws.isReached(3));           // found but not settled yet
+
+    limits.maxSettled = 0;            // 0 is a real bound, not "no limit"
+    Algorithms::dijkstra(g, 2, ws, limits);
+    CHECK(ws.getVisitedCount() == 0);
+    CHECK_FALSE(ws.isReached(2));
+    Algorithms::bfs(g, 2, ws, limits);
+    CHECK(ws.getVisitedCount() == 0);
+    limits.maxSettled = 1;
+    Algorithms::bfs(g, 2, ws, limits);
+    CHECK(ws.getVisitedCount() == 1);
+    CHECK(ws.isSettled(2));
+
+    limits = SearchLimits();
+    limits.target = 5;
+    Algorithms::dijkstra(g, 0, ws, limits);
+    CHECK(ws.getDistance(5) == 10);
+    CHECK(ws.getParent(5) == 4);
+
+    Algorithms::dijkstra(g, 5, ws);   // a full run after early exits
+    CHECK(ws.getVisitedCount() == 6);
+    CHECK(ws.getDistance(0) == 10);
+}
+
+//test to check edge lookups and removals through the hash index
+TEST_CASE("Edge index") {
+    Graph g(40);
+    for (int v = 1; v < 40; v++) {
+        g.addEdge(0, v, v);           // vertex 0 is a hub
+    }
+    g.addEdge(3, 4, 1);
+    g.buildEdgeIndex();
+    CHECK(g.hasEdgeIndex());
+    CHECK(g.hasEdge(0, 17));
+    CHECK(g.hasEdge(17, 0));
+    CHECK_FALSE(g.hasEdge(5, 6));
+
+    for (int v = 1; v < 40; v += 2) {
+        g.removeEdge(0, v);
+    }
+    for (int v = 1; v < 40; v++) {
+        CHECK(g.hasEdge(0, v) == (v % 2 == 0));
+        CHECK(hasEdge(g, v, 0) == (v % 2 == 0));
+    }
+    g.addEdge(0, 5, 50);              // new edges are indexed too
+    CHECK(g.hasEdge(5, 0));
+
+    CHECK(g.updateWeight(3, 4, -2));
+    CHECK(hasEdge(g, 4, 3, -2));
+    CHECK(g.getIsNegative());
+    CHECK(g.updateWeight(4, 3, 2));
+    CHECK_FALSE(g.getIsNegative());
+    CHECK_FALSE(g.updateWeight(5, 6, 1));
+
+    Graph plain(3);                   // same answers without the index
+    plain.addEdge(0, 1, 1);
+    CHECK(plain.hasEdge(1, 0));
+    plain.removeEdge(1, 0);
+    CHECK_FALSE(plain.hasEdge(0, 1));
+}
+
+//test to check the counters the graph keeps while edges change
+TEST_CASE("Graph counters") {
+    Graph g(4);
+    CHECK(g.getEdgeCount() == 0);
+    g.addEdge(0, 1, 5);
+    g.addEdge(0, 2, -3);
+    g.addEdge(1, 2, 8);
+    g.addEdge(2, 3, -1);
+    CHECK(g.getEdgeCount() == 4);
+    CHECK(g.getDegree(2) == 3);
+    CHECK(g.getMinWeight() == -3);
+    CHECK(g.getMaxWeight() == 8);
+    CHECK(g.getIsNegative());
+
+    g.removeEdge(2, 0);
+    CHECK(g.getEdgeCount() == 3);
+    CHECK(g.getDegree(0) == 1);
+    CHECK(g.getMinWeight() == -1);
+    CHECK(g.getIsNegative());
+    g.removeEdge(3, 2);
+    CHECK_FALSE(g.getIsNegative());
+    g.removeEdge(3, 2);               // already gone, nothing changes
+    CHECK(g.getEdgeCount() == 2);
+
+    g.updateWeight(1, 2, 1);
+    CHECK(g.getMaxWeight() == 5);
+    CHECK(g.getMinWeight() == 1);
+    CHECK_THROWS_AS(g.getDegree(4), std::out_of_range);
+}
+
+//test to check removing and reweighting many edges at once
+TEST_CASE("Batch edge changes") {
+    Graph g(6);
+    g.addEdge(0, 1, 1);
+    g.addEdge(0, 2, 2);
+    g.addEdge(0, 3, -3);
+    g.addEdge(1, 2, 4);
+    g.addEdge(2, 3, 5);
+    g.addEdge(4, 4, 6);
+    g.addEdge(0, 1, 7);               // parallel to the first edge
+
+    Edge updates[] = {Edge(2, 1, 40), Edge(3, 0, 3), Edge(5, 4, 1), Edge(4, 4, 60)};
+    CHECK(g.updateWeights(updates, 4) == 3);
+    CHECK(hasEdge(g, 1, 2, 40));
+    CHECK(hasEdge(g, 2, 1, 40));
+    CHECK(hasEdge(g, 0, 3, 3));
+    CHECK(hasEdge(g, 4, 4, 60));
+    CHECK_FALSE(g.getIsNegative());
+    CHECK(g.getMaxWeight() == 60);
+
+    Edge removals[] = {Edge(1, 0, 0), Edge(2, 3, 0), Edge(4, 4, 0), Edge(1, 5, 0)};
+    CHECK(g.removeEdges(removals, 4) == 3);
+    CHECK(g.getEdgeCount() == 4);
+    CHECK(g.hasEdge(0, 1));           // only one of the parallel edges went away
+    CHECK_FALSE(g.hasEdge(3, 2));
+    CHECK_FALSE(g.hasEdge(4, 4));
+    CHECK(g.getDegree(4) == 0);
+    CHECK(g.getDegree(0) == 3);
+    CHECK(g.getMaxWeight() == 40);
+
+    Edge bad[] = {Edge(0, 1, 0), Edge(0, 6, 0)};
+    CHECK_THROWS_AS(g.removeEdges(bad, 2), std::out_of_range);
+    CHECK(g.hasEdge(0, 1));           // nothing is removed when the batch is invalid
+}
+
+//test to check that small batches on a big graph only touch the lists they change
+TEST_CASE("Small batches on a big graph" * doctest::timeout(5)) {
+    int n = 300000;
+    Graph g(n);
+    for (int v = 1; v < n; v++) g.addEdge(v - 1, v, 1);
+    Edge same[] = {Edge(7, 8, 5), Edge(8, 7, 9)};   // one pair twice: the later entry wins
+    CHECK(g.updateWeights(same, 2) == 1);
+    CHECK(hasEdge(g, 7, 8, 9));
+    CHECK(hasEdge(g, 8, 7, 9));
+    // a pass over all vertices per batch would make these 2000 batches take seconds
+    bool ok = true;
+    for (int b = 0; b < 2000; b++) {
+        int v = 1 + (b * 7919) % (n - 1);
+        Edge batch[] = {Edge(v - 1, v, 0)};
+        ok = ok && g.updateWeights(batch, 1) == 1 && g.removeEdges(batch, 1) == 1;
+        g.addEdge(v - 1, v, 1);
+    }
+    CHECK(ok);
+    CHECK(g.getEdgeCount() == n - 1);
+    CHECK(g.getMaxWeight() == 9);
+}
+
+//test to check a directed graph and the algorithms that run on it
+TEST_CASE("Directed graph") {
+    Graph g(5, true, true);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 2, 3);
+    g.addEdge(2, 0, 1);
+    g.addEdge(2, 3, 4);
+    g.addEdge(3, 4, 5);
+    CHECK(g.isDirected());
+    CHECK(g.hasEdge(0, 1));
+    CHECK_FALSE(g.hasEdge(1, 0));
+    CHECK(g.getEdgeCount() == 5);
+    CHECK(g.getDegree(2) == 2);
+    CHECK(g.getInDegree(0) == 1);
+
+    Graph tree = Algorithms::dijkstra(g, 1);
+    CHECK(tree.isDirected());
+    CHECK(hasEdge(tree, 2, 0, 1));
+    CHECK_FALSE(hasEdge(tree, 0, 2));
+    CHECK_NOTHROW(Algorithms::bfs(g, 3));
+    CHECK_NOTHROW(Algorithms::dfs(g, 3));
+    CHECK_THROWS_AS(Algorithms::kruskal(g), std::logic_error);
+    CHECK_THROWS_AS(Algorithms::prim(g, 0), std::logic_error);
+
+    Workspace ws(5);
+    Algorithms::bfs(g, 3, ws);
+    CHECK(ws.getVisitedCount() == 2);
+    Algorithms::reverseBfs(g, 3, ws);
+    CHECK(ws.getVisitedCount() == 4);   // 0, 1 and 2 can reach 3
+    CHECK(ws.getDistance(1) == 2);
+
+    int component[5];
+    CHECK(Algorithms::stronglyConnectedComponents(g, component) == 3);
+    CHECK(component[0] == component[1]);
+    CHECK(component[1] == component[2]);
+    CHECK(component[3] != component[0]);
+    CHECK(component[4] != component[3]);
+
+    g.removeEdge(2, 0);
+    CHECK_FALSE(g.hasEdge(2, 0));
+    Algorithms::reverseBfs(g, 0, ws);
+    CHECK(ws.getVisitedCount() == 1);
+    Edge changes[] = {Edge(0, 1, -2), Edge(3, 4, 1)};
+    CHECK(g.updateWeights(changes, 2) == 2);
+    CHECK(g.getIsNegative());
+    CHECK(g.removeEdges(changes, 2) == 2);
+    CHECK(g.getEdgeCount() == 2);
+    CHECK(g.getInDegree(4) == 0);
+    CHECK(g.getInAdjList()[1] == nullptr);
+
+    Graph noIn(2, true);
+    CHECK_THROWS_AS(Algorithms::reverseBfs(noIn, 0, ws), std::invalid_argument);
+    Workspace ws2(2);
+    CHECK_THROWS_AS(Algorithms::reverseBfs(noIn, 0, ws2), std::logic_error);
+}
+
+//test to check that published snapshots never change under their readers
+TEST_CASE("Versioned graph snapshots") {
+    VersionedGraph vg(100);
+    vg.addEdge(0, 1, 4);
+    CHECK(vg.snapshot()->getEdgeCount() == 0);   // not published yet
+    std::shared_ptr<const GraphSnapshot> v2 = vg.publish();
+    CHECK(v2->getEdgeCount() == 1);
+    CHECK(v2->getVersion() == 2);
+
+    vg.addEdge(1, 70, 2);
+    vg.updateWeight(0, 1, -1);
+    std::shared_ptr<const GraphSnapshot> v3 = vg.publish();
+    CHECK(v2->getDegree(1) == 1);                // the old version is untouched
+    CHECK_FALSE(v2->getIsNegative());
+    CHECK(v3->getDegree(1) == 2);
+    CHECK(v3->getIsNegative());
+    CHECK(vg.removeEdge(0, 1));
+    CHECK_FALSE(vg.removeEdge(0, 1));
+    std::shared_ptr<const GraphSnapshot> v4 = vg.publish();
+    CHECK_FALSE(v4->getIsNegative());
+
+    Workspace ws(100);
+    Algorithms::bfs(*v3, 0, ws);
+    CHECK(ws.getDistance(70) == 2);
+    Algorithms::dijkstra(*v4, 1, ws);
+    CHECK(ws.getDistance(70) == 2);
+    CHECK_FALSE(ws.isReached(0));
+
+    Graph g(3);
+    g.addEdge(0, 1, 1);
+    g.addEdge(1, 2, 1);
+    VersionedGraph fromGraph(g);
+    CHECK(fromGraph.snapshot()->getEdgeCount() == 2);
+    CHECK(fromGraph.snapshot()->getDegree(1) == 2);
+    CHECK_FALSE(fromGraph.snapshot()->getIsNegative());
+
+    g.addEdge(0, 2, -3);
+    CHECK(g.getNegativeCount() == 1);
+    VersionedGraph fromNegative(g);
+    CHECK(fromNegative.snapshot()->getEdgeCount() == 3);
+    CHECK(fromNegative.snapshot()->getIsNegative());
+}
+
+//test to check readers running while the writer keeps publishing
+TEST_CASE("Versioned graph concurrent readers") {
+    const int n = 200;
+    VersionedGraph vg(n);
+    std::atomic<bool> stop(false);
+    std::atomic<int> badReads(0);
+    auto reader = [&]() {
+        Workspace ws(n);
+        while (!stop) {
+            std::shared_ptr<const GraphSnapshot> snap = vg.snapshot();
+            Algorithms::bfs(*snap, 0, ws);
+            // the writer builds the path 0-1-2-..., so a version with k edges reaches k+1 vertices
+            if (ws.getVisitedCount() != snap->getEdgeCount() + 1) {
+                badReads++;
+            }
+        }
+    };
+    std::thread r1(reader);
+    std::thread r2(reader);
+    for (int i = 0; i + 1 < n; i++) {
+        vg.addEdge(i, i + 1, 1);
+        vg.publish();
+    }
+    stop = true;
+    r1.join();
+    r2.join();
+    CHECK(badReads == 0);
+    CHECK(vg.snapshot()->getEdgeCount() == n - 1);
+}
+
+//test to check moving and cloning graphs
+TEST_CASE("Graph move and clone") {
+    Graph g(4);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, -4);
+    g.addEdge(2, 2, 1);
+    g.buildEdgeIndex();
+
+    Graph copy = g.clone();
+    CHECK(copy.getEdgeCount() == 3);
+    CHECK(copy.getIsNegative());
+    CHECK(copy.hasEdgeIndex());
+    CHECK(hasEdge(copy, 2, 1, -4));
+    copy.removeEdge(1, 2);            // nodes from the bulk block can be removed
+    copy.addEdge(0, 3, 7);
+    copy.removeEdge(2, 2);
+    CHECK_FALSE(copy.hasEdge(1, 2));
+    CHECK(g.hasEdge(1, 2));           // the original is untouched
+    CHECK(g.getDegree(2) == 3);
+
+    Graph moved(std::move(copy));
+    CHECK(moved.getNumVertices() == 4);
+    CHECK(moved.hasEdge(3, 0));
+    CHECK(copy.getNumVertices() == 0);
+
+    Graph target(1);
+    target = std::move(moved);
+    CHECK(target.getEdgeCount() == 2);
+    CHECK(moved.getNumVertices() == 0);
+
+    Graph directed(3, true, true);
+    directed.addEdge(0, 1, 1);
+    directed.addEdge(2, 1, 1);
+    Graph directedCopy = directed.clone();
+    CHECK(directedCopy.isDirected());
+    CHECK(directedCopy.getInDegree(1) == 2);
+    AdjacencyView in = directedCopy.inEdgeView();
+    int count = 0;
+    in.forEachNeighbor(1, [&](int, int) { count++; return true; });
+    CHECK(count == 2);
+}
+
+//test to check the vertex orders and that renumbering keeps every edge
+TEST_CASE("Vertex reordering") {
+    // a path 0-1-...-7 with scrambled ids
+    int label[] = {5, 2, 7, 0, 3, 6, 1, 4};
+    Graph g(8);
+    for (int i = 0; i < 7; i++) {
+        g.addEdge(label[i], label[i + 1], i + 1);
+    }
+    g.addEdge(2, 2, 9);
+
+    Permutation rcm = Reordering::reverseCuthillMcKee(g);
+    Graph r = Reordering::apply(g, rcm);
+    CHECK(r.getEdgeCount() == g.getEdgeCount());
+    for (int i = 0; i < 7; i++) {
+        int a = rcm.toNew(label[i]);
+        int b = rcm.toNew(label[i + 1]);
+        CHECK(hasEdge(r, a, b, i + 1));
+        CHECK((a - b == 1 || b - a == 1));   // a path gets consecutive ids
+    }
+    CHECK(hasEdge(r, rcm.toNew(2), rcm.toNew(2), 9));
+
+    Permutation byDegree = Reordering::degreeOrder(g);
+    CHECK(byDegree.toOld(0) == 2);            // the vertex with the self loop has degree 4
+    for (int v = 0; v < 8; v++) {
+        CHECK(byDegree.toOld(byDegree.toNew(v)) == v);
+    }
+
+    Permutation bfs = Reordering::bfsOrder(g, label[0]);
+    CHECK(bfs.toNew(label[0]) == 0);
+    CHECK(bfs.toNew(label[7]) == 7);
+
+    // results on the renumbered graph translate back to the original ids
+    Workspace ws(8);
+    Graph rb = Reordering::apply(g, bfs);
+    Algorithms::bfs(rb, 0, ws);
+    int hopsByNew[8];
+    int hopsByOld[8];
+    for (int v = 0; v < 8; v++) {
+        hopsByNew[v] = ws.getDistance(v);
+    }
+    bfs.toOriginalOrder(hopsByNew, hopsByOld);
+    CHECK(hopsByOld[label[3]] == 3);
+
+    Permutation small(3);
+    CHECK_THROWS_AS(Reordering::apply(g, small), std::invalid_argument);
+}
+
+//test to check that the CSR and compressed copies hold the same edges and give the same searches
+TEST_CASE("Compact and compressed graph storage") {
+    Graph g(6);
+    g.addEdge(0, 1, 4);
+    g.addEdge(0, 2, -1);
+    g.addEdge(1, 3, 7);
+    g.addEdge(2, 3, 2);
+    g.addEdge(3, 4, 1000);
+    g.addEdge(4, 4, 3);
+    CompactGraph csr(g);
+    CompressedGraph packed(g);
+    CHECK(csr.getEdgeCount() == 6);
+    CHECK(packed.getIsNegative());
+    for (int u = 0; u < 6; u++) {
+        CHECK(csr.getDegree(u) == g.getDegree(u));
+        CHECK(packed.getDegree(u) == g.getDegree(u));
+        int last = -1;
+        int count = 0;
+        packed.forEachNeighbor(u, [&](int v, int w) {
+            CHECK(v >= last);                 // lists are sorted
+            CHECK(hasEdge(g, u, v, w));
+            last = v;
+            count++;
+            return true;
+        });
+        CHECK(count == g.getDegree(u));
+        csr.forEachNeighbor(u, [&](int v, int w) { CHECK(hasEdge(g, u, v, w)); return true; });
+    }
+    CHECK_THROWS_AS(packed.getDegree(6), std::out_of_range);
+
+    Graph positive(6);
+    positive.addEdge(0, 1, 4);
+    positive.addEdge(1, 2, 1);
+    positive.addEdge(0, 2, 9);
+    positive.addEdge(2, 5, 2);
+    CompactGraph positiveCsr(positive);
+    CompressedGraph positivePacked(positive);
+    Workspace a(6), b(6), c(6);
+    Algorithms::dijkstra(positive, 0, a);
+    Algorithms::dijkstra(positiveCsr, 0, b);
+    Algorithms::dijkstra(positivePacked, 0, c);
+    for (int v = 0; v < 6; v++) {
+        CHECK(b.getDistance(v) == a.getDistance(v));
+        CHECK(c.getDistance(v) == a.getDistance(v));
+    }
+    CHECK(c.getDistance(5) == 7);
+    Algorithms::bfs(positivePacked, 0, c);
+    CHECK(c.getDistance(5) == 2);
+
+    // a long path with equal weights: one byte per edge end, no weight bits
+    Graph path(1000);
+    for (int i = 0; i + 1 < 1000; i++) {
+        path.addEdge(i, i + 1, 1);
+    }
+    CompressedGraph small(path);
+    CompactGraph plain(path);
+    CHECK(small.getMemoryBytes() < plain.getMemoryBytes());
+    CHECK(small.getBytesPerEdge() < 40);
+    Workspace big(1000);
+    Algorithms::bfs(small, 0, big);
+    CHECK(big.getDistance(999) == 999);
+
+    // a larger graph with local neighbors (as after reordering), average degree 16
+    Graph local(50000);
+    unsigned int seed = 3;
+    for (int u = 0; u < 50000; u++) {
+        for (int k = 0; k < 8; k++) {
+            int v = u + 1 + nextRandom(seed, 100);
+            if (v < 50000) local.addEdge(u, v, 1 + nextRandom(seed, 10));
+        }
+    }
+    CompressedGraph localPacked(local);
+    CHECK(localPacked.getBytesPerEdge() < 4);
+
+    // a hub whose list alone is longer than 64 KB gets 4-byte offsets for its block
+    Graph hub(40000);
+    for (int v = 1; v < 40000; v++) {
+        hub.addEdge(0, v, v % 300);
+        hub.addEdge(v, (v * 7) % 40000, 1);
+    }
+    CompactGraph hubCsr(hub);
+    CompressedGraph hubPacked(hub);
+    bool same = true;
+    for (int u = 0; u < 40000; u += 37) {
+        unsigned long long fromCsr = 0, fromPacked = 0;
+        hubCsr.forEachNeighbor(u, [&](int v, int w) { fromCsr = fromCsr * 31 + v * 1000 + w; return true; });
+        hubPacked.forEachNeighbor(u, [&](int v, int w) { fromPacked = fromPacked * 31 + v * 1000 + w; return true; });
+        same = same && fromCsr == fromPacked && hubPacked.getDegree(u) == hubCsr.getDegree(u);
+    }
+    CHECK(same);
+    CHECK(hubPacked.getDegree(0) == hubCsr.getDegree(0));
+}
+
+//test to check that the weight-free neighbor walk sees the same neighbors on every representation
+TEST_CASE("Neighbor walk without weights") {
+    Graph g(5);
+    g.addEdge(0, 3, 8);
+    g.addEdge(0, 1, 2);
+    g.addEdge(1, 4, 5);
+    g.addEdge(3, 3, 1);
+    CompactGraph csr(g);
+    CompressedGraph packed(g);
+    VersionedGraph versioned(g);
+    std::shared_ptr<const GraphSnapshot> snap = versioned.snapshot();
+    for (int u = 0; u < 5; u++) {
+        int fromGraph = 0, fromCsr = 0, fromPacked = 0, fromSnapshot = 0;
+        g.forEachAdjacent(u, [&](int v) { fromGraph += v + 1; return true; });
+        csr.forEachAdjacent(u, [&](int v) { fromCsr += v + 1; return true; });
+        packed.forEachAdjacent(u, [&](int v) { fromPacked += v + 1; return true; });
+        snap->forEachAdjacent(u, [&](int v) { fromSnapshot += v + 1; return true; });
+        CHECK(fromCsr == fromGraph);
+        CHECK(fromPacked == fromGraph);
+        CHECK(fromSnapshot == fromGraph);
+    }
+    // the walk stops as soon as f returns false
+    int seen = 0;
+    CHECK_FALSE(csr.forEachAdjacent(0, [&](int) { seen++; return false; }));
+    CHECK(seen == 1);
+    int first = -1;
+    csr.forEachAdjacent(0, [&](int v) { first = v; return false; });
+    CHECK(first == 1);                    // sorted, so 1 comes before 3
+
+    // 8 bytes per edge end: one int for the neighbor, one for the weight
+    CHECK(csr.getMemoryBytes() == 6 * 8 + 8 * 8);
+}
+
+//test to check the sorted-set intersection kernels and the neighborhood queries built on them
+TEST_CASE("Sorted neighbor intersection") {
+    int a[] = {1, 3, 4, 7, 9, 12, 15, 20, 21, 30};
+    int b[] = {0, 3, 7, 8, 9, 10, 20, 30, 31};
+    int out[9];
+    CHECK(Intersection::count(a, 10, b, 9) == 5);
+    CHECK(Intersection::intersect(a, 10, b, 9, out) == 5);
+    int expected[] = {3, 7, 9, 20, 30};
+    for (int i = 0; i < 5; i++) {
+        CHECK(out[i] == expected[i]);
+    }
+    CHECK(Intersection::count(a, 0, b, 9) == 0);
+
+    // random sets against a brute force count, so the 4 x 4 blocks meet every alignment
+    unsigned int seed = 7;
+    int x[64], y[64];
+    for (int round = 0; round < 50; round++) {
+        int nx = 0, ny = 0;
+        for (int v = 0; v < 150; v++) {
+            if (nextRandom(seed, 3) == 0 && nx < 64) x[nx++] = v;
+            if (nextRandom(seed, 3) == 0 && ny < 64) y[ny++] = v;
+        }
+        int brute = 0;
+        for (int i = 0; i < nx; i++)
+            for (int j = 0; j < ny; j++)
+                brute += x[i] == y[j];
+        CHECK(Intersection::count(x, nx, y, ny) == brute);
+        CHECK(Intersection::countDistinct(x, nx, y, ny) == brute);
+    }
+
+    int withRepeats[] = {2, 2, 5, 5, 5, 8};
+    int other[] = {2, 5, 5, 9};
+    CHECK(Intersection::countDistinct(withRepeats, 6, other, 4) == 2);
+    CHECK(Intersection::distinct(withRepeats, 6) == 3);
+
+    // 0 and 1 share the neighbors 2, 3 and 4
+    Graph g(6);
+    for (int v = 2; v <= 4; v++) {
+        g.addEdge(0, v, 1);
+        g.addEdge(1, v, 1);
+    }
+    g.addEdge(0, 5, 1);
+    CompactGraph csr(g);
+    CHECK_FALSE(csr.hasRepeatedNeighbors());
+    CHECK(Algorithms::commonNeighbors(csr, 0, 1) == 3);
+    CHECK(Algorithms::jaccard(csr, 0, 1) == doctest::Approx(0.75));
+    CHECK(Algorithms::jaccard(csr, 5, 5) == doctest::Approx(1.0));
+
+    g.addEdge(1, 2, 4);                   // a parallel edge does not change the sets
+    CompactGraph multi(g);
+    CHECK(multi.hasRepeatedNeighbors());
+    CHECK(Algorithms::commonNeighbors(multi, 0, 1) == 3);
+    CHECK(Algorithms::jaccard(multi, 0, 1) == doctest::Approx(0.75));
+    CHECK_THROWS_AS(csr.getNeighbors(6), std::out_of_range);
+}
+
+//test to check triangle counts and clustering coefficients, single and multi threaded
+TEST_CASE("Triangle counting") {
+    // K4 on 0..3 plus a pendant vertex 4 hanging off 3
+    Graph g(6);
+    for (int u = 0; u < 4; u++)
+        for (int v = u + 1; v < 4; v++)
+            g.addEdge(u, v, 1);
+    g.addEdge(3, 4, 1);
+    g.addEdge(0, 1, 5);                   // parallel edge and self loop change nothing
+    g.addEdge(2, 2, 1);
+    CompactGraph csr(g);
+    long long perVertex[6];
+    CHECK(Algorithms::countTriangles(csr) == 4);
+    CHECK(Algorithms::countTriangles(csr, perVertex, 1) == 4);
+    CHECK(perVertex[0] == 3);
+    CHECK(perVertex[3] == 3);
+    CHECK(perVertex[4] == 0);
+    CHECK(perVertex[5] == 0);
+
+    double cc[6];
+    double average = Algorithms::clusteringCoefficients(csr, cc, 2);
+    CHECK(cc[0] == doctest::Approx(1.0));
+    CHECK(cc[3] == doctest::Approx(0.5));  // 3 of the 6 pairs among {0, 1, 2, 4}
+    CHECK(cc[4] == doctest::Approx(0.0));
+    CHECK(average == doctest::Approx(3.5 / 6));
+
+    // a bigger random graph: every thread count agrees with a brute force count
+    int n = 300;
+    Graph r(n);
+    bool *adj = new bool[n * n]();
+    unsigned int seed = 11;
+    for (int i = 0; i < 3000; i++) {
+        int u = nextRandom(seed, n);
+        int v = nextRandom(seed, n);
+        if (u == v || adj[u * n + v]) continue;
+        adj[u * n + v] = adj[v * n + u] = true;
+        r.addEdge(u, v, 1);
+    }
+    long long brute = 0;
+    long long bruteAt0 = 0;
+    for (int u = 0; u < n; u++)
+        for (int v = u + 1; v < n; v++)
+            if (adj[u * n + v])
+                for (int w = v + 1; w < n; w++)
+                    if (adj[u * n + w] && adj[v * n + w]) {
+                        brute++;
+                        if (u == 0) bruteAt0++;
+                    }
+    CompactGraph big(r);
+    long long *counts = new long long[n];
+    for (int threads = 1; threads <= 4; threads++) {
+        CHECK(Algorithms::countTriangles(big, counts, threads) == brute);
+        long long sum = 0;
+        for (int v = 0; v < n; v++) sum += counts[v];
+        CHECK(sum == 3 * brute);
+        CHECK(counts[0] == bruteAt0);
+    }
+    delete[] counts;
+    delete[] adj;
+
+    Graph directed(3, true);
+    CompactGraph directedCsr(directed);
+    CHECK_THROWS_AS(Algorithms::countTriangles(directedCsr), std::logic_error);
+}
+
+//test to check that both component labelings agree and number components by their first vertex
+TEST_CASE("Connected components") {
+    Graph g(7);
+    g.addEdge(5, 6, 1);
+    g.addEdge(1, 3, 1);
+    g.addEdge(3, 0, 1);
+    g.addEdge(4, 4, 2);
+    int serial[7], parallel[7];
+    CHECK(Algorithms::connectedComponents(g, serial) == 4);
+    int expected[] = {0, 0, 1, 0, 2, 3, 3};   // {0,1,3} {2} {4} {5,6}
+    CompactGraph csr(g);
+    CHECK(Algorithms::parallelConnectedComponents(csr, parallel, 3) == 4);
+    for (int v = 0; v < 7; v++) {
+        CHECK(serial[v] == expected[v]);
+        CHECK(parallel[v] == expected[v]);
+    }
+
+    Graph directed(3, true);
+    directed.addEdge(2, 0, 1);
+    int weak[3];
+    CHECK(Algorithms::connectedComponents(directed, weak) == 2);
+    CHECK(weak[2] == weak[0]);
+
+    // a long scrambled path plus isolated vertices needs many hook rounds
+    int n = 5000;
+    Graph big(n);
+    for (int i = 0; i + 1 < 4000; i++) {
+        big.addEdge((i * 7919) % 4000, ((i + 1) * 7919) % 4000, 1);
+    }
+    CompactGraph bigCsr(big);
+    int *a = new int[n];
+    int *b = new int[n];
+    CHECK(Algorithms::connectedComponents(big, a) == 1001);
+    for (int threads = 1; threads <= 4; threads++) {
+        CHECK(Algorithms::parallelConnectedComponents(bigCsr, b, threads) == 1001);
+        bool same = true;
+        for (int v = 0; v < n; v++) same = same && a[v] == b[v];
+        CHECK(same);
+        CHECK(Algorithms::parallelConnectedComponents(bigCsr, b, threads, CONCURRENT_UNION_FIND) == 1001);
+        same = true;
+        for (int v = 0; v < n; v++) same = same && a[v] == b[v];
+        CHECK(same);
+    }
+    CHECK(Algorithms::parallelConnectedComponents(csr, parallel, 2, CONCURRENT_UNION_FIND) == 4);
+    CHECK(parallel[6] == 3);
+    CHECK(a[3999] == 0);
+    CHECK(a[4000] == 1);
+    delete[] a;
+    delete[] b;
+    CHECK_THROWS_AS(Algorithms::connectedComponents(g, nullptr), std::invalid_argument);
+}
+
+//test to check the concurrent union-find alone and under many threads
+TEST_CASE("ConcurrentUnionFind") {
+    ConcurrentUnionFind uf(6);
+    CHECK(uf.unite(4, 2));
+    CHECK_FALSE(uf.unite(2, 4));
+    CHECK(uf.find(4) == 2);               // the smaller index becomes the root
+    CHECK(uf.unite(5, 4));
+    CHECK(uf.componentSize(5) == 3);
+    CHECK(uf.componentSize(0) == 1);
+    CHECK(uf.componentCount() == 4);
+    CHECK(uf.connected(2, 4));
+    CHECK_FALSE(uf.connected(0, 4));
+    CHECK_THROWS_AS(uf.find(6), std::out_of_range);
+
+    // 8 threads unite overlapping chains: i with i + 2 inside 0..n-1 gives
+    // exactly 2 sets (evens and odds), whatever the interleaving
+    int n = 20000;
+    int numThreads = 8;
+    ConcurrentUnionFind shared(n);
+    std::atomic<int> merges(0);
+    std::thread threads[8];
+    for (int t = 0; t < numThreads; t++) {
+        threads[t] = std::thread([&, t]() {
+            for (int i = t; i + 2 < n; i += numThreads / 2) {
+                if (shared.unite(i + 2, i)) merges++;
+                shared.connected(i, n - 1 - i);
+            }
+        });
+    }
+    for (int t = 0; t < numThreads; t++) {
+        threads[t].join();
+    }
+    CHECK(merges == n - 2);               // every successful unite joined two sets
+    bool ok = true;
+    for (int i = 0; i < n; i++) {
+        ok = ok && shared.find(i) == i % 2;
+    }
+    CHECK(ok);
+    CHECK(shared.componentCount() == 2);
+    CHECK(shared.componentSize(0) == n / 2);
+    CHECK(shared.componentSize(n - 1) == n / 2);
+    CHECK(shared.connected(0, n - 2));
+    CHECK_FALSE(shared.connected(0, n - 1));
+}
+
+//test to check union by size and every path compression strategy
+TEST_CASE("UnionFind sizes and path compression") {
+    PathCompression strategies[] = {HALVING, SPLITTING, FULL};
+    for (PathCompression strategy : strategies) {
+        int n = 10000;
+        UnionFind uf(n, strategy);
+        CHECK(uf.componentCount() == n);
+        // a long chain built from the far end so paths get deep without union by size
+        bool merged = true;
+        for (int i = n - 1; i > 0; i--) {
+            merged = uf.unite(i - 1, i) && merged;
+        }
+        CHECK(merged);
+        CHECK_FALSE(uf.unite(0, n - 1));
+        CHECK(uf.componentCount() == 1);
+        CHECK(uf.componentSize(1234) == n);
+        CHECK(uf.connected(0, n - 1));
+    }
+
+    UnionFind uf(6, SPLITTING);
+    uf.unite(0, 1);
+    uf.unite(2, 3);
+    uf.unite(3, 4);
+    CHECK(uf.componentSize(0) == 2);
+    CHECK(uf.componentSize(4) == 3);
+    CHECK(uf.componentSize(5) == 1);
+    CHECK(uf.componentCount() == 3);
+    CHECK(uf.find(1) == uf.find(0));
+    CHECK_THROWS_AS(uf.find(-1), std::out_of_range);
+}
+
+//test to check that graph listeners see every change and that connectivity follows the graph
+TEST_CASE("Incremental connectivity") {
+    struct Recorder : GraphListener {
+        int added = 0, removed = 0, changed = 0, lastOld = 0;
+        void onEdgeAdded(int, int, int) override { added++; }
+        void onEdgeRemoved(int, int, int) override { removed++; }
+        void onWeightChanged(int, int, int oldWeight, int) override { changed++; lastOld = oldWeight; }
+    };
+    Graph g(6);
+    Recorder rec;
+    g.addListener(&rec);
+    g.addEdge(0, 1, 3);
+    g.addEdge(1, 2, 4);
+    g.updateWeight(0, 1, 9);
+    Edge batch[] = {Edge(1, 2, 0)};
+    g.removeEdges(batch, 1);
+    CHECK(rec.added == 2);
+    CHECK(rec.removed == 1);
+    CHECK(rec.changed == 1);
+    CHECK(rec.lastOld == 3);
+    g.removeListener(&rec);
+    g.addEdge(4, 5, 1);
+    CHECK(rec.added == 2);
+
+    // batch changes are reported only once every list (both ends) is up to date
+    struct Checker : GraphListener {
+        const Graph &graph;
+        int expectedEdges;
+        bool consistent = true;
+        Checker(const Graph &graph, int expectedEdges) : graph(graph), expectedEdges(expectedEdges) {}
+        void onEdgeRemoved(int u, int v, int) override {
+            consistent = consistent && !graph.hasEdge(u, v) && !graph.hasEdge(v, u) && graph.getEdgeCount() == expectedEdges;
+        }
+        void onWeightChanged(int u, int v, int, int w) override {
+            int seen = 0;
+            graph.forEachNeighbor(u, [&](int x, int weight) { if (x == v && weight == w) seen++; return true; });
+            graph.forEachNeighbor(v, [&](int x, int weight) { if (x == u && weight == w) seen++; return true; });
+            consistent = consistent && seen == 2;
+        }
+    };
+    Graph h(6);
+    for (int v = 1; v < 6; v++) h.addEdge(0, v, v);
+    h.addEdge(2, 3, 1);
+    Checker checker(h, 3);
+    h.addListener(&checker);
+    Edge heavier[] = {Edge(0, 1, 10), Edge(2, 3, 20), Edge(0, 5, 30)};
+    CHECK(h.updateWeights(heavier, 3) == 3);
+    Edge gone[] = {Edge(0, 2, 0), Edge(3, 0, 0), Edge(2, 3, 0)};
+    CHECK(h.removeEdges(gone, 3) == 3);
+    CHECK(checker.consistent);
+    h.removeListener(&checker);
+
+    // same for a directed graph: the out list of u and the in list of v are both done
+    struct DirectedChecker : GraphListener {
+        const Graph &graph;
+        bool consistent = true;
+        DirectedChecker(const Graph &graph) : graph(graph) {}
+        int inWeights(int u, int v, int w) {
+            int seen = 0;
+            graph.inEdgeView().forEachNeighbor(v, [&](int x, int weight) { if (x == u && weight == w) seen++; return true; });
+            return seen;
+        }
+        void onEdgeRemoved(int u, int v, int w) override {
+            consistent = consistent && !graph.hasEdge(u, v) && inWeights(u, v, w) == 0;
+        }
+        void onWeightChanged(int u, int v, int, int w) override {
+            consistent = consistent && inWeights(u, v, w) == 1;
+        }
+    };
+    Graph d(5, true, true);
+    for (int v = 1; v < 5; v++) d.addEdge(0, v, v);
+    d.addEdge(3, 1, 1);
+    DirectedChecker directedChecker(d);
+    d.addListener(&directedChecker);
+    Edge directedHeavier[] = {Edge(0, 1, 10), Edge(3, 1, 20)};
+    CHECK(d.updateWeights(directedHeavier, 2) == 2);
+    Edge directedGone[] = {Edge(0, 1, 0), Edge(3, 1, 0), Edge(0, 4, 0)};
+    CHECK(d.removeEdges(directedGone, 3) == 3);
+    CHECK(directedChecker.consistent);
+    d.removeListener(&directedChecker);
+
+    IncrementalConnectivity conn(g);          // {0,1} {2} {3} {4,5}
+    CHECK(conn.componentCount() == 4);
+    CHECK(conn.connected(4, 5));
+    g.addEdge(1, 2, 1);
+    g.addEdge(2, 3, 1);
+    CHECK(conn.connected(0, 3));
+    CHECK(conn.componentSize(3) == 4);
+    CHECK(conn.componentCount() == 2);
+    CHECK_FALSE(conn.isStale());
+
+    g.removeEdge(2, 3);                       // splits the graph, noticed at the rebuild
+    CHECK(conn.isStale());
+    CHECK(conn.connected(0, 3));
+    conn.rebuild();
+    CHECK_FALSE(conn.connected(0, 3));
+    CHECK(conn.componentCount() == 3);
+    CHECK_FALSE(conn.isStale());
+
+    // background rebuild while edges keep arriving and readers keep asking
+    g.removeEdge(0, 1);
+    conn.rebuildAsync();
+    std::atomic<bool> stop(false);
+    std::thread reader([&]() {
+        while (!stop) conn.componentCount();
+    });
+    g.addEdge(3, 4, 1);                       // either replayed or already in the copy
+    conn.waitForRebuild();
+    stop = true;
+    reader.join();
+    CHECK_FALSE(conn.isStale());
+    CHECK_FALSE(conn.connected(0, 1));
+    CHECK(conn.connected(3, 5));
+    CHECK(conn.componentCount() == 3);        // {0} {1,2} {3,4,5}
+
+    // a move leaves the listeners on the source, the new graph reports nothing
+    {
+        Graph source(3);
+        IncrementalConnectivity watcher(source);
+        Graph target(std::move(source));
+        target.addEdge(0, 1, 1);
+        CHECK_FALSE(watcher.connected(0, 1));
+        Graph assigned(2);
+        assigned = std::move(target);
+        assigned.addEdge(1, 2, 1);
+        source.addListener(&rec);             // the emptied source still takes listeners
+        source.removeListener(&rec);
+    }                                         // watcher detaches from source, not from a moved-to graph
+
+    // a graph moved into keeps its listeners, and they follow the new content and size
+    {
+        Graph small(3);
+        small.addEdge(0, 1, 1);
+        IncrementalConnectivity watcher(small);
+        DynamicSSSP paths(small, 0);
+        DynamicMST forest(small);
+        Graph big(1000);
+        big.addEdge(0, 500, 4);
+        small = std::move(big);
+        CHECK(watcher.componentCount() == 999);
+        CHECK_FALSE(watcher.connected(0, 1));
+        CHECK(paths.getDistance(500) == 4);
+        CHECK(forest.isStale());
+        small.addEdge(900, 901, 1);
+        small.addEdge(500, 900, 2);
+        CHECK(watcher.connected(0, 901));
+        CHECK(paths.getDistance(901) == 7);
+
+        Graph tiny(1);                        // the source 0 survives, vertex 1 does not
+        small = std::move(tiny);
+        CHECK(watcher.componentCount() == 1);
+        CHECK(paths.getDistance(0) == 0);
+        CHECK_THROWS_AS(paths.getDistance(1), std::out_of_range);
+        Graph negative(2);
+        negative.addEdge(0, 1, -1);
+        small = std::move(negative);
+        CHECK(paths.isStale());
+        CHECK(paths.getDistance(1) == -1);
+        CHECK_THROWS_AS(paths.recompute(), std::logic_error);
+        small.removeEdge(0, 1);
+        paths.recompute();
+        CHECK_FALSE(paths.isStale());
+    }
+}
+
+//test to check the link-cut tree and that the dynamic forest always matches Kruskal
+TEST_CASE("Link-cut tree and dynamic MST") {
+    LinkCutTree lct(6);
+    for (int v = 0; v < 6; v++) lct.setValue(v, v * 10);
+    lct.link(0, 1);
+    lct.link(1, 2);
+    lct.link(3, 2);
+    CHECK(lct.connected(0, 3));
+    CHECK_FALSE(lct.connected(0, 4));
+    CHECK(lct.pathMax(0, 3) == 3);
+    CHECK(lct.pathMax(1, 0) == 1);
+    CHECK_THROWS_AS(lct.link(0, 3), std::logic_error);
+    CHECK_THROWS_AS(lct.cut(0, 2), std::logic_error);
+    lct.cut(2, 1);
+    CHECK_FALSE(lct.connected(0, 3));
+    CHECK(lct.findRoot(3) == lct.findRoot(2));
+    lct.setValue(2, 99);
+    CHECK(lct.pathMax(3, 2) == 2);
+
+    // edges arrive one by one; after each batch the forest weight matches Kruskal
+    int n = 40;
+    Graph g(n);
+    DynamicMST mst(g);
+    unsigned int seed = 3;
+    for (int round = 0; round < 6; round++) {
+        for (int i = 0; i < 30; i++) {
+            int u = nextRandom(seed, n);
+            int v = nextRandom(seed, n);
+            g.addEdge(u, v, nextRandom(seed, 50) - 10);
+        }
+        Graph kruskalTree = Algorithms::kruskal(g);
+        CHECK(mst.getTotalWeight() == totalWeight(kruskalTree));
+        CHECK(mst.getEdgeCount() == kruskalTree.getEdgeCount());
+    }
+    Graph forest = mst.toGraph();
+    CHECK(forest.getEdgeCount() == mst.getEdgeCount());
+    int weight = 0;
+    int slot = mst.heaviestOnPath(0, 1, weight);
+    CHECK(slot >= 0);
+    g.addEdge(0, 1, 1000);                // too heavy to matter
+    CHECK_FALSE(mst.isStale());
+    g.removeEdge(0, 1);
+    CHECK(mst.isStale());
+
+    DynamicMST small(3);
+    CHECK(small.addEdge(0, 1, 5));
+    CHECK(small.addEdge(1, 2, 7));
+    CHECK_FALSE(small.addEdge(0, 2, 9));  // heavier than the whole path
+    CHECK(small.addEdge(0, 2, 6));        // replaces 1-2
+    CHECK(small.getTotalWeight() == 11);
+    CHECK_FALSE(small.addEdge(2, 2, 1));
+    Graph directed(2, true);
+    CHECK_THROWS_AS(DynamicMST{directed}, std::logic_error);
+}
+
+//test to check that repaired shortest paths always match a fresh Dijkstra
+TEST_CASE("Dynamic shortest paths") {
+    // a path 0-1-2-3-4 plus a long detour 0-5-4
+    Graph g(7);
+    for (int i = 0; i < 4; i++) g.addEdge(i, i + 1, 1);
+    g.addEdge(0, 5, 5);
+    g.addEdge(5, 4, 5);
+    DynamicSSSP sp(g, 0);
+    CHECK(sp.getDistance(4) == 4);
+    CHECK(sp.getDistance(6) == -1);
+    CHECK(sp.getParent(4) == 3);
+
+    g.addEdge(1, 6, 2);                   // only 6 changes
+    CHECK(sp.getDistance(6) == 3);
+    CHECK(sp.getTouchedCount() == 1);
+    g.updateWeight(0, 5, 1);              // cheaper detour, but 1 + 5 still loses to 4
+    CHECK(sp.getDistance(5) == 1);
+    CHECK(sp.getDistance(4) == 4);
+    g.removeEdge(2, 3);                   // 3 and 4 lose their path, the detour takes over
+    CHECK(sp.getDistance(4) == 6);
+    CHECK(sp.getDistance(3) == 7);
+    CHECK(sp.getParent(3) == 4);
+    g.removeEdge(0, 1);                   // non-tree removals of 5 do not matter, this one does
+    CHECK(sp.getDistance(1) == -1);
+    CHECK(sp.getDistance(6) == -1);
+    CHECK(sp.getParent(2) == -1);
+
+    // random changes, checked against Dijkstra after each one
+    for (int directed = 0; directed <= 1; directed++) {
+        int n = 60;
+        Graph d(n, directed == 1, true);
+        unsigned int seed = 5;
+        auto next = [&]() { return nextRandom(seed, 100000); };
+        for (int i = 0; i < 150; i++) d.addEdge(next() % n, next() % n, next() % 20);
+        DynamicSSSP dsp(d, 0);
+        Workspace ws(n);
+        bool same = true;
+        for (int step = 0; step < 300; step++) {
+            int u = next() % n, v = next() % n, kind = next() % 3;
+            if (kind == 0) d.addEdge(u, v, next() % 20);
+            else if (kind == 1) d.removeEdge(u, v);
+            else d.updateWeight(u, v, next() % 20);
+            if (step % 50 == 49) {               // batches are reported once all lists agree
+                Edge batch[] = {Edge(u, v, 0), Edge(v, u, 0), Edge(u, (u + 1) % n, 0)};
+                d.removeEdges(batch, 3);
+                Edge heavier[] = {Edge(v, (v + 1) % n, 30), Edge((v + 2) % n, v, 40)};
+                d.updateWeights(heavier, 2);
+            }
+            Algorithms::dijkstra(d, 0, ws);
+            for (int x = 0; x < n; x++) same = same && dsp.getDistance(x) == ws.getDistance(x);
+        }
+        CHECK(same);
+    }
+
+    g.addEdge(2, 5, -1);
+    CHECK(sp.isStale());
+    Graph negative(2);
+    negative.addEdge(0, 1, -3);
+    CHECK_THROWS_AS(DynamicSSSP(negative, 0), std::logic_error);
+    Graph noInEdges(2, true);
+    CHECK_THROWS_AS(DynamicSSSP(noInEdges, 0), std::logic_error);
+}